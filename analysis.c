@@ -0,0 +1,281 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: analysis.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <math.h>
+
+// Local definitions
+#include "analysis.h"
+#include "dumps.h"
+#include "info.h"
+#include "workers.h"
+
+// Statistics of a single block
+typedef struct block_stats {
+    double entropy;                     // Shannon entropy in bits per byte
+    size_t zeros;                       // Number of zero bytes
+    size_t text;                        // Number of text bytes
+    size_t distinct;                    // Number of distinct byte values
+} block_stats_t;
+
+// Work assigned to a single worker
+typedef struct analysis_job {
+    const ubyte_t* data;                // Chunk data
+    size_t count;                       // Number of bytes in chunk
+    size_t block_size;                  // Size of a block
+    size_t first;                       // First block of the job
+    size_t last;                        // Block after the last block of the job
+    block_stats_t* results;             // Results of the whole chunk
+} analysis_job_t;
+
+// Precomputed c * log2(c) for small counts (filled before any worker starts)
+static double log_table[ANALYSIS_LOG_TABLE_SIZE];
+
+// Fill c * log2(c) table - static function
+static void init_log_table(void) {
+    log_table[0] = 0;
+    for (size_t c = 1; c < ANALYSIS_LOG_TABLE_SIZE; ++c)
+        log_table[c] = c * log2((double)c);
+}
+
+// Count byte values - static function
+static void histogram(const ubyte_t* data, size_t count, size_t* counts) {
+    // Consecutive bytes go to different tables, so that a run of equal bytes
+    // doesn't serialize increments of the same counter
+    udword_t tables[ANALYSIS_HISTOGRAM_TABLES][256];
+    memset(tables, 0, sizeof(tables));
+
+    size_t i = 0;
+    for (; i + 2 * sizeof(udword_t) <= count; i += 2 * sizeof(udword_t)) {
+        // Load two words at once and split them into bytes
+        udword_t low, high;
+        memcpy(&low, data + i, sizeof(udword_t));
+        memcpy(&high, data + i + sizeof(udword_t), sizeof(udword_t));
+
+        ++tables[0][low & 0xff];
+        ++tables[1][(low >> 8) & 0xff];
+        ++tables[2][(low >> 16) & 0xff];
+        ++tables[3][low >> 24];
+        ++tables[0][high & 0xff];
+        ++tables[1][(high >> 8) & 0xff];
+        ++tables[2][(high >> 16) & 0xff];
+        ++tables[3][high >> 24];
+    }
+
+    // Count remaining bytes
+    for (; i < count; ++i)
+        ++tables[0][data[i]];
+
+    // Merge tables together
+    for (int value = 0; value < 256; ++value)
+        counts[value] = (size_t)tables[0][value] + tables[1][value] + tables[2][value] + tables[3][value];
+}
+
+// Analyze single block - static function
+static void analyze_block(const ubyte_t* data, size_t count, block_stats_t* stats) {
+    size_t counts[256];
+    histogram(data, count, counts);
+
+    // Entropy H = log2(n) - sum(c * log2(c)) / n
+    double sum = 0;
+    stats->distinct = 0;
+
+    for (int value = 0; value < 256; ++value) {
+        size_t c = counts[value];
+        if (c == 0)
+            continue;       // Value doesn't appear
+
+        ++stats->distinct;
+        sum += (c < ANALYSIS_LOG_TABLE_SIZE) ? log_table[c] : c * log2((double)c);
+    }
+
+    stats->entropy = (count > 0) ? log2((double)count) - sum / count : 0;
+
+    // Text bytes are printable ASCII and common white space
+    stats->text = counts[CHAR_BYTE_VALUE_TAB] + counts[CHAR_BYTE_VALUE_LF] + counts[CHAR_BYTE_VALUE_CR];
+    for (int value = ASCII_LOWEST; value <= ASCII_HIGHEST; ++value)
+        stats->text += counts[value];
+
+    stats->zeros = counts[CHAR_BYTE_VALUE_NULL];
+}
+
+// Classify analyzed block - static function
+static const char* classify_block(const block_stats_t* stats, size_t count) {
+    if (stats->zeros == count)
+        return ANALYSIS_CLASS_EMPTY;
+    if (stats->distinct == 1)
+        return ANALYSIS_CLASS_FILL;
+    if (stats->text >= ANALYSIS_TEXT_RATIO * count)
+        return ANALYSIS_CLASS_TEXT;
+
+    if (count >= ANALYSIS_MIN_BLOCK) {
+        // Expected entropy of uniformly random data drops with block size
+        double random = 8.0 - 255.0 / (2.0 * count * log(2.0)) - ANALYSIS_RANDOM_MARGIN;
+
+        if (stats->entropy >= random)
+            return ANALYSIS_CLASS_RANDOM;
+    }
+
+    return ANALYSIS_CLASS_BINARY;
+}
+
+// Analyze blocks of a job - static function
+static void analyze_job(analysis_job_t* job) {
+    for (size_t block = job->first; block < job->last; ++block) {
+        // Last block of the chunk may be incomplete
+        size_t begin = block * job->block_size;
+        size_t count = job->count - begin;
+        if (count > job->block_size)
+            count = job->block_size;
+
+        analyze_block(job->data + begin, count, &job->results[block]);
+    }
+}
+
+// Worker thread routine - static function
+static unsigned int __stdcall analysis_worker(void* context) {
+    analyze_job((analysis_job_t*)context);
+    return 0;
+}
+
+// Print entropy and byte statistics of each block
+int analyze_entropy(
+    FILE* file,
+    size_t block_size,
+    unsigned int workers,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    // Format:
+    // "%07x" or greater for offset of each block
+    // 2 spaces
+    // entropy in bits per byte, ratio of zero bytes, ratio of text bytes and block class
+    // If end of file reached, only offset is printed
+
+    int retcode = 0;
+
+    // Calculate number of digits based on ending offset
+    size_t ndigits = get_offset_digits(endoffset);
+
+    // Chunk is made of whole blocks
+    size_t chunk_size = ANALYSIS_CHUNK_SIZE - ANALYSIS_CHUNK_SIZE % block_size;
+    if (chunk_size == 0)
+        chunk_size = block_size;
+    size_t chunk_blocks = chunk_size / block_size;
+
+    // Two buffers, so that next chunk can be read while workers process current one
+    ubyte_t* buffers[2];
+    buffers[0] = malloc(chunk_size);
+    buffers[1] = malloc(chunk_size);
+    block_stats_t* results = malloc(chunk_blocks * sizeof(block_stats_t));
+    analysis_job_t* jobs = malloc(MAX_WORKERS * sizeof(analysis_job_t));
+
+    if (!buffers[0] || !buffers[1] || !results || !jobs) {
+        // Not enough memory for buffers
+        print_error_memory("Out of memory");
+
+        retcode = ENOMEM;
+        goto tidy_up;
+    }
+
+    init_log_table();
+
+    // Read first chunk
+    size_t current = 0;
+    size_t count = (endoffset - *position < chunk_size) ? endoffset - *position : chunk_size;
+
+    if (fread(buffers[current], BYTE_SIZE, count, file) < count) {
+        // An error occured while reading file
+        print_file_error("An error occured while file contents output");
+
+        retcode = errno;
+        goto tidy_up;
+    }
+
+    while (count > 0) {
+        size_t nblocks = (count + block_size - 1) / block_size;
+        workers_t running;
+        running.count = 0;
+
+        // Split blocks of the chunk evenly between workers
+        unsigned int njobs = (nblocks < workers) ? (unsigned int)nblocks : workers;
+        for (unsigned int i = 0; i < njobs; ++i) {
+            jobs[i].data = buffers[current];
+            jobs[i].count = count;
+            jobs[i].block_size = block_size;
+            jobs[i].first = nblocks * i / njobs;
+            jobs[i].last = nblocks * (i + 1) / njobs;
+            jobs[i].results = results;
+        }
+
+        if (njobs < 2 || !workers_start(&running, njobs, analysis_worker, jobs, sizeof(analysis_job_t))) {
+            // Single worker (or threads unavailable) -> analyze on this thread
+            jobs[0].first = 0;
+            jobs[0].last = nblocks;
+            analyze_job(&jobs[0]);
+        }
+
+        // Read next chunk while workers are busy
+        size_t next_position = *position + count;
+        size_t next_count = (endoffset - next_position < chunk_size) ? endoffset - next_position : chunk_size;
+        size_t next_read = fread(buffers[!current], BYTE_SIZE, next_count, file);
+
+        workers_wait(&running);
+
+        // Print out statistics of each block
+        for (size_t block = 0; block < nblocks; ++block) {
+            size_t block_count = (count - block * block_size < block_size) ? count - block * block_size : block_size;
+
+            print_offset(stdout, ndigits, *position + block * block_size);
+            fprintf(stdout, ANALYSIS_FORMAT,
+                results[block].entropy,
+                100.0 * results[block].zeros / block_count,
+                100.0 * results[block].text / block_count,
+                classify_block(&results[block], block_count));
+        }
+
+        // Get new position from number of analyzed bytes
+        *position = next_position;
+
+        if (next_read < next_count) {
+            // An error occured while reading file
+            print_file_error("An error occured while file contents output");
+
+            retcode = errno;
+            goto tidy_up;
+        }
+
+        // Swap buffers
+        current = !current;
+        count = next_count;
+    }
+
+    // Reached end of range
+    print_offset(stdout, ndigits, *position);       // Print ending position
+    putchar('\n');                                  // Last line feed
+
+    tidy_up:
+    free(buffers[0]);
+    free(buffers[1]);
+    free(results);
+    free(jobs);
+
+    return retcode;
+}
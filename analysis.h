@@ -0,0 +1,51 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: analysis.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                     // Measure for file descriptor
+#ifndef __ANALYSIS_H__
+#define __ANALYSIS_H__
+
+// Define constants
+#define ANALYSIS_CHUNK_SIZE             16777216    // Bytes read at once (rounded down to whole blocks)
+#define ANALYSIS_MIN_BLOCK              256         // Smallest block with meaningful entropy
+#define ANALYSIS_HISTOGRAM_TABLES       4           // Interleaved histogram tables
+#define ANALYSIS_LOG_TABLE_SIZE         65536       // Precomputed c * log2(c) values
+
+// Block classification thresholds
+#define ANALYSIS_TEXT_RATIO             0.9         // Minimum ratio of text bytes for text block
+#define ANALYSIS_RANDOM_MARGIN          0.1         // Distance from entropy of random data
+
+// Block classes
+#define ANALYSIS_CLASS_EMPTY            "empty"     // All bytes are zero
+#define ANALYSIS_CLASS_FILL             "fill"      // All bytes have the same value
+#define ANALYSIS_CLASS_TEXT             "text"      // Mostly printable ASCII
+#define ANALYSIS_CLASS_RANDOM           "random"    // Compressed or encrypted data
+#define ANALYSIS_CLASS_BINARY           "binary"    // Anything else (code, structures, ...)
+
+// Output format
+#define ANALYSIS_FORMAT                 "  entropy %5.3f  zero %5.1f%%  text %5.1f%%  %s\n"
+
+// Declare functions
+int analyze_entropy(
+    FILE* file,
+    size_t block_size,
+    unsigned int workers,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+);      // Print entropy and byte statistics of each block
+
+#endif
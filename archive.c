@@ -0,0 +1,516 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: archive.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// Local definitions
+#include "archive.h"
+#include "inflate.h"
+#include "dumps.h"
+#include "ranges.h"
+#include "records.h"
+#include "device.h"
+#include "info.h"
+
+// Get little endian 16-bit value - static function
+static unsigned int get16(const ubyte_t* data) {
+    return data[0] | (unsigned int)data[1] << 8;
+}
+
+// Get little endian 32-bit value - static function
+static uqword_t get32(const ubyte_t* data) {
+    return get16(data) | (uqword_t)get16(data + 2) << 16;
+}
+
+// Get little endian 64-bit value - static function
+static uqword_t get64(const ubyte_t* data) {
+    return get32(data) | get32(data + 4) << 32;
+}
+
+// Read bytes at given offset of archive - static function
+static bool read_at(archive_t* archive, uqword_t offset, void* buffer, size_t count) {
+    if (offset > archive->fsize || archive->fsize - offset < count)
+        return false;       // Beyond the end of archive
+
+    return input_seek(archive->file, archive->options.alignment, (size_t)offset) == 0
+        && fread(buffer, BYTE_SIZE, count, archive->file) == count;
+}
+
+// Report damaged archive - static function
+static int damaged(void) {
+    print_error("Archive is damaged or truncated");
+
+    return EILSEQ;
+}
+
+// Pass decompressed data within dumped range on to the dump - static function
+static bool archive_feed(void* context, const ubyte_t* data, size_t count) {
+    archive_sink_t* sink = (archive_sink_t*)context;
+    uqword_t start = sink->produced;
+    sink->produced += count;
+
+    // Parts before and after the range are dropped
+    size_t skip = (start < sink->begin) ? (size_t)(sink->begin - start) : 0;
+    size_t keep = (sink->produced > sink->end) ? count - (size_t)(sink->produced - sink->end) : count;
+    if (keep > skip)
+        dump_feed(sink->state, data + skip, keep - skip);
+
+    return sink->produced < sink->end;      // Rest of member isn't needed
+}
+
+// Dump member if it is selected - static function
+static int dump_member(archive_t* archive, archive_member_t* member) {
+    bool all = strcmp(archive->select, ARCHIVE_ALL) == 0;
+    if (!all && strcmp(archive->select, member->name) != 0)
+        return 0;       // Member isn't selected
+
+    ++archive->dumped;
+
+    if (member->encrypted || (member->method != ZIP_STORED && member->method != ZIP_DEFLATED)) {
+        // Member is reported and skipped, remaining members are dumped
+        char message[ARCHIVE_MAX_NAME + 64];
+        if (member->encrypted)
+            snprintf(message, sizeof(message), "Member %s is encrypted", member->name);
+        else
+            snprintf(message, sizeof(message), "Member %s uses unsupported compression method %u", member->name, member->method);
+        print_error(message);
+        archive->error = ENOTSUP;
+
+        return 0;
+    }
+
+    if (member->data == 0) {
+        // Zip member data follows its local header (read once the member is selected)
+        ubyte_t header[ZIP_LOCAL_SIZE];
+        if (!read_at(archive, member->header, header, ZIP_LOCAL_SIZE) || get32(header) != ZIP_LOCAL_HEADER)
+            return damaged();
+
+        member->data = member->header + ZIP_LOCAL_SIZE + get16(header + 26) + get16(header + 28);
+    }
+
+    if (member->data > archive->fsize || archive->fsize - member->data < member->stored)
+        return damaged();       // Member data reaches beyond the end of archive
+
+    if (all)
+        // Members are told apart by their names
+        printf((archive->dumped > 1) ? "\n" ARCHIVE_MEMBER_FORMAT : ARCHIVE_MEMBER_FORMAT, member->name);
+
+    // Offsets are counted from the member beginning
+    range_t range;
+    range.begin = 0;
+    range.end = (size_t)member->size;
+    if (archive->range)
+        range_resolve(archive->range, (size_t)member->size, &range);
+
+    int retcode;
+    if (member->method == ZIP_STORED) {
+        // Stored member is dumped right from the archive
+        size_t position = range.begin;
+        retcode = input_seek(archive->file, archive->options.alignment, (size_t)member->data + range.begin);
+        if (retcode == 0)
+            retcode = dump_stream(archive->file, stdout, archive->format, &archive->options, range.begin, &position, range.end);
+    }
+    else {
+        // Deflated member is dumped as it is decompressed
+        dump_state_t state;
+        if (!dump_init(&state, archive->format, &archive->options, stdout, range.begin, range.end))
+            retcode = ENOMEM;
+        else {
+            archive_sink_t sink;
+            sink.state = &state;
+            sink.produced = 0;
+            sink.begin = range.begin;
+            sink.end = range.end;
+
+            retcode = input_seek(archive->file, archive->options.alignment, (size_t)member->data);
+            if (retcode == 0 && range.begin < range.end)
+                retcode = inflate_file(archive->file, member->stored, archive_feed, &sink);
+
+            if (retcode == 0)
+                dump_end(&state);
+            else {
+                // Keep what was dumped so far
+                dump_flush(&state);
+                free(state.buffer);
+            }
+        }
+    }
+
+    if (retcode == ENOMEM)
+        // Not enough memory for buffers
+        print_error_memory("Out of memory");
+    else if (retcode != 0) {
+        // An error occured while reading or decompressing member
+        putchar('\n');      // Divide space between data and error message
+        errno = retcode;
+        print_file_error((retcode == EILSEQ) ? "Member data couldn\'t be decompressed" : "An error occured while file contents output");
+    }
+
+    return retcode;
+}
+
+// Get number from tar header field (octal digits or base-256 with highest bit set) - static function
+static uqword_t tar_number(const ubyte_t* field, size_t length) {
+    uqword_t value = 0;
+
+    if (field[0] & 0x80) {
+        // Base-256 number (large sizes)
+        value = field[0] & 0x7f;
+        for (size_t i = 1; i < length; ++i)
+            value = value << 8 | field[i];
+
+        return value;
+    }
+
+    for (size_t i = 0; i < length && field[i] != 0; ++i) {
+        // Octal digits, padded by spaces
+        if (field[i] >= '0' && field[i] <= '7')
+            value = value * 8 + (field[i] - '0');
+    }
+
+    return value;
+}
+
+// Check tar header checksum (sum of all bytes, checksum field counted as spaces) - static function
+static bool tar_valid(const ubyte_t* header) {
+    uqword_t sum = 0;
+    for (size_t i = 0; i < ARCHIVE_TAR_BLOCK; ++i)
+        sum += (i >= TAR_CHECKSUM && i < TAR_CHECKSUM + TAR_CHECKSUM_LENGTH) ? ' ' : header[i];
+
+    return sum == tar_number(header + TAR_CHECKSUM, TAR_CHECKSUM_LENGTH);
+}
+
+// Copy name field of given maximal length (not terminated if it is full) - static function
+static size_t copy_field(char* name, const ubyte_t* field, size_t length) {
+    size_t count = 0;
+    while (count < length && field[count] != 0)
+        ++count;
+
+    memcpy(name, field, count);
+    name[count] = 0;
+
+    return count;
+}
+
+// Get path and size of next member from extended tar header - static function
+static void tar_pax(const char* records, size_t count, char* name, bool* has_name, uqword_t* size, bool* has_size) {
+    size_t i = 0;
+    while (i < count) {
+        // Each record is "<length> <key>=<value>\n", length includes the whole record
+        size_t length = 0;
+        size_t j = i;
+        while (j < count && records[j] >= '0' && records[j] <= '9')
+            length = length * 10 + (records[j++] - '0');
+
+        if (length == 0 || j >= count || records[j] != ' ' || length > count - i)
+            return;     // Malformed record ends parsing
+
+        const char* key = records + j + 1;
+        const char* end = records + i + length - 1;     // Line feed ending the record
+        const char* equals = memchr(key, '=', end - key);
+        if (equals) {
+            size_t value_length = end - equals - 1;
+            if ((size_t)(equals - key) == 4 && memcmp(key, "path", 4) == 0 && value_length < ARCHIVE_MAX_NAME) {
+                memcpy(name, equals + 1, value_length);
+                name[value_length] = 0;
+                *has_name = true;
+            }
+            else if ((size_t)(equals - key) == 4 && memcmp(key, "size", 4) == 0) {
+                *size = 0;
+                for (const char* digit = equals + 1; digit < end && *digit >= '0' && *digit <= '9'; ++digit)
+                    *size = *size * 10 + (*digit - '0');
+                *has_size = true;
+            }
+        }
+
+        i += length;
+    }
+}
+
+// Dump selected members of tar archive - static function
+static int tar_members(archive_t* archive) {
+    ubyte_t header[ARCHIVE_TAR_BLOCK];
+    archive_member_t member;
+    char* extended = malloc(ARCHIVE_MAX_PAX);
+    bool has_name = false;      // Name stated by previous header
+    bool has_size = false;      // Size stated by previous header
+    uqword_t size = 0;
+    uqword_t position = 0;
+
+    if (!extended) {
+        // Not enough memory for extended headers
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    while (read_at(archive, position, header, ARCHIVE_TAR_BLOCK)) {
+        bool empty = true;
+        for (size_t i = 0; i < ARCHIVE_TAR_BLOCK && empty; ++i)
+            empty = header[i] == 0;
+
+        if (empty)
+            break;      // End of archive
+
+        if (!tar_valid(header)) {
+            free(extended);
+
+            return damaged();
+        }
+
+        // Member data follows its header, aligned to whole blocks
+        uqword_t stored = tar_number(header + TAR_SIZE, TAR_SIZE_LENGTH);
+        uqword_t data = position + ARCHIVE_TAR_BLOCK;
+        char type = (char)header[TAR_TYPE];
+        position = data + (stored + ARCHIVE_TAR_BLOCK - 1) / ARCHIVE_TAR_BLOCK * ARCHIVE_TAR_BLOCK;
+
+        if (type == TAR_TYPE_LONG_NAME || type == TAR_TYPE_PAX) {
+            // Header of next member
+            size_t count = (stored < ARCHIVE_MAX_PAX) ? (size_t)stored : ARCHIVE_MAX_PAX - 1;
+            if (!read_at(archive, data, extended, count)) {
+                free(extended);
+
+                return damaged();
+            }
+
+            if (type == TAR_TYPE_LONG_NAME) {
+                copy_field(member.name, (ubyte_t*)extended, (count < ARCHIVE_MAX_NAME) ? count : ARCHIVE_MAX_NAME - 1);
+                has_name = true;
+            }
+            else
+                tar_pax(extended, count, member.name, &has_name, &size, &has_size);
+
+            continue;
+        }
+
+        if (!has_name) {
+            // Prefix and name of ustar header
+            size_t count = 0;
+            if (memcmp(header + TAR_MAGIC, "ustar", 5) == 0 && header[TAR_PREFIX] != 0) {
+                count = copy_field(member.name, header + TAR_PREFIX, TAR_PREFIX_LENGTH);
+                member.name[count++] = '/';
+            }
+            copy_field(member.name + count, header + TAR_NAME, TAR_NAME_LENGTH);
+        }
+
+        member.header = 0;
+        member.data = data;
+        member.size = member.stored = (has_size) ? size : stored;
+        member.method = ZIP_STORED;
+        member.encrypted = false;
+        has_name = has_size = false;
+
+        // Position of next header is known before the member is dumped
+        if (stored != member.stored)
+            position = data + (member.stored + ARCHIVE_TAR_BLOCK - 1) / ARCHIVE_TAR_BLOCK * ARCHIVE_TAR_BLOCK;
+
+        if (type == TAR_TYPE_FILE || type == TAR_TYPE_OLD_FILE || type == TAR_TYPE_CONTIGUOUS) {
+            // Regular files only
+            int retcode = dump_member(archive, &member);
+            if (retcode != 0) {
+                free(extended);
+
+                return retcode;
+            }
+        }
+    }
+
+    free(extended);
+
+    return 0;
+}
+
+// Find end of central directory at the end of zip archive - static function
+static bool zip_find(archive_t* archive, uqword_t* directory, uqword_t* entries) {
+    size_t count = (archive->fsize < ARCHIVE_ZIP_TAIL) ? archive->fsize : ARCHIVE_ZIP_TAIL;
+    uqword_t start = archive->fsize - count;
+    ubyte_t* tail = malloc((count > 0) ? count : 1);
+
+    if (!tail || count < ZIP_END_SIZE || !read_at(archive, start, tail, count)) {
+        free(tail);
+        return false;
+    }
+
+    // Record is followed by its comment only (ending the file exactly), last one is searched for
+    size_t i = count - ZIP_END_SIZE;
+    bool found = false;
+    for (;;) {
+        found = get32(tail + i) == ZIP_END && get16(tail + i + 20) == count - i - ZIP_END_SIZE;
+        if (found || i == 0)
+            break;
+
+        --i;
+    }
+
+    if (!found) {
+        free(tail);
+        return false;
+    }
+
+    *entries = get16(tail + i + 10);
+    *directory = get32(tail + i + 16);
+    uqword_t size = get32(tail + i + 12);
+    uqword_t end = start + i;           // Central directory is followed by this record
+
+    if ((*entries == 0xffff || *directory == 0xffffffff || size == 0xffffffff) && i >= ZIP64_LOCATOR_SIZE && get32(tail + i - ZIP64_LOCATOR_SIZE) == ZIP64_LOCATOR) {
+        // Zip64 record holds the values that don't fit
+        ubyte_t record[ZIP64_END_SIZE];
+        uqword_t offset = get64(tail + i - ZIP64_LOCATOR_SIZE + 8);
+        if (read_at(archive, offset, record, ZIP64_END_SIZE) && get32(record) == ZIP64_END) {
+            *entries = get64(record + 32);
+            size = get64(record + 40);
+            *directory = get64(record + 48);
+            end = offset;
+        }
+    }
+
+    free(tail);
+
+    // Record of a zip stored inside another archive doesn't describe this file
+    if (*directory > end || end - *directory != size)
+        return false;
+
+    return true;
+}
+
+// Dump selected members of zip archive listed in its central directory - static function
+static int zip_members(archive_t* archive, uqword_t directory, uqword_t entries) {
+    ubyte_t header[ZIP_CENTRAL_SIZE];
+    archive_member_t member;
+    ubyte_t* fields = malloc(2 * 65536);       // Name and extra fields of one entry
+    uqword_t position = directory;
+
+    if (!fields) {
+        // Not enough memory for fields
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    for (uqword_t entry = 0; entry < entries; ++entry) {
+        if (!read_at(archive, position, header, ZIP_CENTRAL_SIZE) || get32(header) != ZIP_CENTRAL_HEADER) {
+            free(fields);
+
+            return damaged();
+        }
+
+        size_t name_length = get16(header + 28);
+        size_t extra_length = get16(header + 30);
+        size_t comment_length = get16(header + 32);
+        if (!read_at(archive, position + ZIP_CENTRAL_SIZE, fields, name_length + extra_length)) {
+            free(fields);
+
+            return damaged();
+        }
+        position += ZIP_CENTRAL_SIZE + name_length + extra_length + comment_length;
+
+        copy_field(member.name, fields, (name_length < ARCHIVE_MAX_NAME) ? name_length : ARCHIVE_MAX_NAME - 1);
+        member.method = get16(header + 10);
+        member.encrypted = (get16(header + 8) & ZIP_ENCRYPTED) != 0;
+        member.stored = get32(header + 20);
+        member.size = get32(header + 24);
+        member.header = get32(header + 42);
+        member.data = 0;
+
+        for (size_t i = name_length; i + 4 <= name_length + extra_length; ) {
+            // Zip64 field holds the values that don't fit, in this order
+            size_t id = get16(fields + i);
+            size_t length = get16(fields + i + 2);
+            const ubyte_t* value = fields + i + 4;
+            const ubyte_t* end = value + length;
+            i += 4 + length;
+            if (id != ZIP64_EXTRA || i > name_length + extra_length)
+                continue;
+
+            if (member.size == 0xffffffff && value + 8 <= end) {
+                member.size = get64(value);
+                value += 8;
+            }
+            if (member.stored == 0xffffffff && value + 8 <= end) {
+                member.stored = get64(value);
+                value += 8;
+            }
+            if (member.header == 0xffffffff && value + 8 <= end)
+                member.header = get64(value);
+        }
+
+        size_t length = strlen(member.name);
+        if (length > 0 && member.name[length - 1] == '/')
+            continue;       // Directory
+
+        int retcode = dump_member(archive, &member);
+        if (retcode != 0) {
+            free(fields);
+
+            return retcode;
+        }
+    }
+
+    free(fields);
+
+    return 0;
+}
+
+// Dump given member (or all members) of tar or zip archive with offsets inside the member
+int archive_dump(
+    FILE* file,
+    size_t fsize,
+    const char* member,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_spec_t* range
+) {
+    archive_t archive;
+    archive.file = file;
+    archive.fsize = fsize;
+    archive.select = member;
+    archive.format = format;
+    archive.options = *options;
+    archive.options.output = OUTPUT_TEXT;       // Members are told apart by lines with their names
+    archive.range = range;
+    archive.dumped = 0;
+    archive.error = 0;
+
+    int retcode;
+    uqword_t directory, entries;
+    ubyte_t header[ARCHIVE_TAR_BLOCK];
+    if (read_at(&archive, 0, header, ARCHIVE_TAR_BLOCK) && tar_valid(header))
+        // Tar archive begins with a header (checked first, its last member may be a zip)
+        retcode = tar_members(&archive);
+    else if (zip_find(&archive, &directory, &entries))
+        // Zip archive ends with its central directory
+        retcode = zip_members(&archive, directory, entries);
+    else {
+        print_error("File is neither a tar nor a zip archive");
+
+        return EINVAL;
+    }
+
+    if (retcode != 0)
+        return retcode;
+
+    if (archive.dumped == 0) {
+        // Stated member isn't in archive
+        print_error("Member wasn\'t found in archive");
+
+        return ENOENT;
+    }
+
+    return archive.error;
+}
@@ -0,0 +1,108 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: archive.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for dump format and options
+#include "ranges.h"                     // Measure for stated range
+#ifndef __ARCHIVE_H__
+#define __ARCHIVE_H__
+
+// Define constants
+#define ARCHIVE_ALL                     "*"         // Member name selecting all members
+#define ARCHIVE_MAX_NAME                4096        // Longest member name kept
+#define ARCHIVE_MAX_PAX                 65536       // Largest extended tar header parsed
+#define ARCHIVE_TAR_BLOCK               512         // Tar header and data alignment
+#define ARCHIVE_ZIP_TAIL                65557       // End of central directory with longest comment
+#define ARCHIVE_MEMBER_FORMAT           "%s:\n"     // Line before each member when all are dumped
+
+// Tar header fields
+#define TAR_NAME                        0
+#define TAR_NAME_LENGTH                 100
+#define TAR_SIZE                        124
+#define TAR_SIZE_LENGTH                 12
+#define TAR_CHECKSUM                    148
+#define TAR_CHECKSUM_LENGTH             8
+#define TAR_TYPE                        156
+#define TAR_MAGIC                       257
+#define TAR_PREFIX                      345
+#define TAR_PREFIX_LENGTH               155
+
+// Tar member types
+#define TAR_TYPE_FILE                   '0'
+#define TAR_TYPE_OLD_FILE               '\0'
+#define TAR_TYPE_CONTIGUOUS             '7'
+#define TAR_TYPE_LONG_NAME              'L'         // GNU name of next member
+#define TAR_TYPE_PAX                    'x'         // Extended header of next member
+
+// Zip records
+#define ZIP_LOCAL_HEADER                0x04034b50
+#define ZIP_CENTRAL_HEADER              0x02014b50
+#define ZIP_END                         0x06054b50
+#define ZIP64_END                       0x06064b50
+#define ZIP64_LOCATOR                   0x07064b50
+#define ZIP_LOCAL_SIZE                  30
+#define ZIP_CENTRAL_SIZE                46
+#define ZIP_END_SIZE                    22
+#define ZIP64_END_SIZE                  56
+#define ZIP64_LOCATOR_SIZE              20
+#define ZIP64_EXTRA                     0x0001      // Extra field with 64-bit sizes and offset
+#define ZIP_ENCRYPTED                   0x0001      // Flag of encrypted member
+#define ZIP_STORED                      0           // Compression methods
+#define ZIP_DEFLATED                    8
+
+// Member of archive
+typedef struct archive_member {
+    char name[ARCHIVE_MAX_NAME];        // Member name
+    uqword_t header;                    // Offset of local header (zip only)
+    uqword_t data;                      // Offset of member data in archive
+    uqword_t size;                      // Member size
+    uqword_t stored;                    // Bytes of member data in archive
+    unsigned int method;                // Compression method
+    bool encrypted;                     // Member data is encrypted
+} archive_member_t;
+
+// Archive being dumped
+typedef struct archive {
+    FILE* file;                         // Archive file
+    size_t fsize;                       // Archive size
+    const char* select;                 // Name of dumped member (ARCHIVE_ALL for all of them)
+    const dump_format_t* format;        // Line format
+    dump_options_t options;             // Dump options
+    const range_spec_t* range;          // Range of each member (NULL for whole member)
+    size_t dumped;                      // Number of members dumped so far
+    int error;                          // Error of member skipped in the middle (0 if there is none)
+} archive_t;
+
+// Decompressed member passed on to the dump
+typedef struct archive_sink {
+    dump_state_t* state;                // Dump state
+    uqword_t produced;                  // Decompressed bytes so far
+    size_t begin;                       // Beginning of dumped range
+    size_t end;                         // End of dumped range
+} archive_sink_t;
+
+// Declare functions
+int archive_dump(
+    FILE* file,
+    size_t fsize,
+    const char* member,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_spec_t* range
+);      // Dump given member (or all members) of tar or zip archive with offsets inside the member
+
+#endif
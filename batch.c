@@ -0,0 +1,410 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: batch.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <direct.h>
+#include <windows.h>
+
+// Local definitions
+#include "batch.h"
+#include "dumps.h"
+#include "ranges.h"
+#include "device.h"
+#include "records.h"
+#include "checksum.h"
+#include "workers.h"
+#include "info.h"
+
+// Growing list of paths
+typedef struct path_list {
+    char** paths;                       // Paths
+    size_t count;                       // Number of paths
+    size_t capacity;                    // Allocated number of paths
+} path_list_t;
+
+// Add copy of a path to list - static function
+static bool add_path(path_list_t* list, const char* path) {
+    if (list->count == list->capacity) {
+        // Double the capacity
+        size_t capacity = (list->capacity > 0) ? list->capacity * 2 : 64;
+        char** paths = realloc(list->paths, capacity * sizeof(char*));
+        if (!paths)
+            return false;
+
+        list->paths = paths;
+        list->capacity = capacity;
+    }
+
+    size_t length = strlen(path);
+    char* copy = malloc(length + 1);
+    if (!copy)
+        return false;
+
+    memcpy(copy, path, length + 1);
+    list->paths[list->count++] = copy;
+
+    return true;
+}
+
+// Add paths listed in a file, one per line - static function
+static int add_list(path_list_t* list, const char* listpath) {
+    char line[BATCH_MAX_PATH];
+    FILE* file = fopen(listpath, "r");
+
+    if (!file)
+        return errno;
+
+    while (fgets(line, sizeof(line), file)) {
+        // Strip line ending, skip empty lines
+        line[strcspn(line, "\r\n")] = 0;
+        if (line[0] == 0)
+            continue;
+
+        if (!add_path(list, line)) {
+            fclose(file);
+            return ENOMEM;
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// Free list of paths - static function
+static void free_paths(path_list_t* list) {
+    for (size_t i = 0; i < list->count; ++i)
+        free(list->paths[i]);
+    free(list->paths);
+}
+
+// Get file name part of a path - static function
+static const char* get_base_name(const char* path) {
+    // File name follows the last backslash, slash or drive colon
+    const char* name = path;
+    for (const char* c = path; *c != 0; ++c) {
+        if (*c == '\\' || *c == '/' || *c == ':')
+            name = c + 1;
+    }
+
+    return name;
+}
+
+// Output name of an input path (sorted to find the same names)
+typedef struct batch_name {
+    const char* name;                   // Output name without extension
+    size_t index;                       // Index of input path
+} batch_name_t;
+
+// Compare output names the way file system does (case doesn't matter), then paths in given order - static function
+static int compare_names(const void* a, const void* b) {
+    const batch_name_t* first = a;
+    const batch_name_t* second = b;
+
+    int result = _stricmp(first->name, second->name);
+    if (result != 0)
+        return result;
+
+    return (first->index > second->index) - (first->index < second->index);
+}
+
+// Find output names shared by several input paths - static function
+static bool find_same_names(batch_name_t* sorted, char** names, size_t count, bool* same) {
+    for (size_t i = 0; i < count; ++i) {
+        sorted[i].name = names[i];
+        sorted[i].index = i;
+        same[i] = false;
+    }
+    qsort(sorted, count, sizeof(batch_name_t), compare_names);
+
+    // Every name but the first of a kind (in order of paths) is marked
+    bool found = false;
+    for (size_t i = 1; i < count; ++i) {
+        if (_stricmp(sorted[i - 1].name, sorted[i].name) == 0) {
+            same[sorted[i].index] = true;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+// Give every input path its own output name - static function
+static int assign_names(const path_list_t* list, char** names) {
+    batch_name_t* sorted = malloc(((list->count > 0) ? list->count : 1) * sizeof(batch_name_t));
+    bool* same = malloc((list->count > 0) ? list->count : 1);
+    int retcode = 0;
+
+    if (!sorted || !same) {
+        retcode = ENOMEM;
+        goto tidy_up;
+    }
+
+    // Output file is named after input file
+    for (size_t i = 0; i < list->count; ++i) {
+        const char* base = get_base_name(list->paths[i]);
+        names[i] = malloc(strlen(base) + 1);
+        if (!names[i]) {
+            retcode = ENOMEM;
+            goto tidy_up;
+        }
+        strcpy(names[i], base);
+    }
+
+    if (!find_same_names(sorted, names, list->count, same))
+        goto tidy_up;
+
+    // Files of the same name from different directories get their number in the batch added
+    for (size_t i = 0; i < list->count; ++i) {
+        if (!same[i])
+            continue;
+
+        size_t length = strlen(names[i]) + 24;
+        char* name = malloc(length);
+        if (!name) {
+            retcode = ENOMEM;
+            goto tidy_up;
+        }
+        snprintf(name, length, "%s.%llu", names[i], (unsigned long long)(i + 1));
+        free(names[i]);
+        names[i] = name;
+    }
+
+    // Numbered name may still be taken by another input file
+    if (find_same_names(sorted, names, list->count, same))
+        retcode = EEXIST;
+
+    tidy_up:
+    free(sorted);
+    free(same);
+
+    return retcode;
+}
+
+// Free output names - static function
+static void free_names(char** names, size_t count) {
+    if (!names)
+        return;
+
+    for (size_t i = 0; i < count; ++i)
+        free(names[i]);
+    free(names);
+}
+
+// Get extension of output files - static function
+static const char* get_extension(int output) {
+    switch (output) {
+    case OUTPUT_JSON:
+        return BATCH_EXTENSION_JSON;
+    case OUTPUT_CSV:
+        return BATCH_EXTENSION_CSV;
+    case OUTPUT_BINARY:
+        return BATCH_EXTENSION_BINARY;
+    default:
+        return BATCH_EXTENSION_TEXT;
+    }
+}
+
+// Dump single file of batch - static function
+static int batch_file(const batch_t* batch, size_t index) {
+    char target[BATCH_MAX_PATH];
+    const char* path = batch->paths[index];
+    int output = batch->options->output;
+
+    // Output file is named after input file (unique within the batch)
+    size_t dirlen = strlen(batch->directory);
+    bool separated = dirlen > 0 && (batch->directory[dirlen - 1] == '\\' || batch->directory[dirlen - 1] == '/');
+    int written = snprintf(target, sizeof(target), "%s%s%s%s", batch->directory, (separated) ? "" : "\\", batch->names[index], get_extension(output));
+
+    if (written < 0 || (size_t)written >= sizeof(target))
+        return ENAMETOOLONG;
+
+    FILE* file = fopen(path, "rbS");      // Files are read from beginning to end
+    if (!file)
+        return errno;
+
+    // Range is resolved against size of each file (or device)
+    dump_options_t options = *batch->options;
+    size_t fsize = input_prepare(file, &options.alignment);
+    range_t range;
+    range.begin = 0;
+    range.end = fsize;
+    if (batch->range)
+        range_resolve(batch->range, fsize, &range);
+
+    FILE* out = fopen(target, (output == OUTPUT_BINARY) ? "wb" : "w");
+    if (!out) {
+        int error = errno;
+        fclose(file);
+        return error;
+    }
+
+    if (output != OUTPUT_TEXT)
+        record_start(out, output, options.checksum);
+
+    size_t position = range.begin;
+    int retcode = input_seek(file, options.alignment, range.begin);
+    if (retcode == 0)
+        retcode = dump_stream(file, out, batch->format, &options, range.begin, &position, range.end);
+
+    // Write errors (such as full disk) show up when the output is closed
+    if (fclose(out) != 0 && retcode == 0)
+        retcode = errno;
+    fclose(file);
+
+    return retcode;
+}
+
+// Worker thread routine - static function
+static unsigned int __stdcall batch_worker(void* context) {
+    batch_t* batch = *(batch_t**)context;
+
+    for (;;) {
+        // Take next path until there is none left
+        size_t index = (size_t)InterlockedIncrement(&batch->next) - 1;
+        if (index >= batch->count)
+            break;
+
+        batch->results[index] = batch_file(batch, index);
+    }
+
+    return 0;
+}
+
+// Dump each file into its own output file in given directory
+int dump_batch(
+    char** args,
+    size_t count,
+    const char* directory,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_spec_t* range,
+    unsigned int workers
+) {
+    path_list_t list;
+    list.paths = NULL;
+    list.count = list.capacity = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        // Arguments are paths or names of files listing paths
+        int error = (args[i][0] == BATCH_LIST_PREFIX) ? add_list(&list, args[i] + 1) : (add_path(&list, args[i]) ? 0 : ENOMEM);
+
+        if (error == ENOMEM) {
+            // Not enough memory for paths
+            free_paths(&list);
+            print_error_memory("Out of memory");
+
+            return ENOMEM;
+        }
+        if (error != 0) {
+            // List couldn't be read
+            free_paths(&list);
+            errno = error;
+            print_file_error("File list couldn\'t be opened");
+
+            return error;
+        }
+    }
+
+    if (_mkdir(directory) != 0 && errno != EEXIST) {
+        // Output directory doesn't exist and cannot be created
+        int error = errno;
+        free_paths(&list);
+        print_file_error("Output directory couldn\'t be created");
+
+        return error;
+    }
+
+    int* results = calloc((list.count > 0) ? list.count : 1, sizeof(int));
+    char** names = calloc((list.count > 0) ? list.count : 1, sizeof(char*));
+    int error = (results && names) ? assign_names(&list, names) : ENOMEM;
+
+    if (error == ENOMEM) {
+        // Not enough memory for results
+        free(results);
+        free_names(names, list.count);
+        free_paths(&list);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+    if (error != 0) {
+        // Two output files would be written at the same place
+        free(results);
+        free_names(names, list.count);
+        free_paths(&list);
+        print_error("Output files of the batch cannot be told apart, rename the input files");
+
+        return error;
+    }
+
+    // Tables filled on first use are filled before workers start
+    dump_prepare();
+    record_prepare();
+    if (options->checksum != CHECKSUM_NONE) {
+        checksum_t warmup;
+        checksum_init(&warmup, options->checksum);
+    }
+
+    batch_t batch;
+    batch.paths = list.paths;
+    batch.count = list.count;
+    batch.next = 0;
+    batch.results = results;
+    batch.names = names;
+    batch.directory = directory;
+    batch.format = format;
+    batch.options = options;
+    batch.range = range;
+
+    // Every worker takes paths from the shared batch
+    batch_t* contexts[MAX_WORKERS];
+    for (unsigned int i = 0; i < MAX_WORKERS; ++i)
+        contexts[i] = &batch;
+
+    workers_t running;
+    running.count = 0;
+    unsigned int njobs = (list.count < workers) ? (unsigned int)list.count : workers;
+
+    if (njobs < 2 || !workers_start(&running, njobs, batch_worker, contexts, sizeof(batch_t*)))
+        // Single worker (or threads unavailable) -> dump on this thread
+        batch_worker(&contexts[0]);
+    workers_wait(&running);
+
+    // Report failed files in order of paths, first error is the return code
+    int retcode = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < list.count; ++i) {
+        if (results[i] == 0)
+            continue;
+
+        print_path_error(list.paths[i], results[i]);
+        if (retcode == 0)
+            retcode = results[i];
+        ++failed;
+    }
+
+    fprintf(stderr, "%llu of %llu files dumped into %s\n", (unsigned long long)(list.count - failed), (unsigned long long)list.count, directory);
+
+    // Tidy up
+    free(results);
+    free_names(names, list.count);
+    free_paths(&list);
+
+    return retcode;
+}
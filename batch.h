@@ -0,0 +1,54 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: batch.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include "dumps.h"                      // Measure for dump format and options
+#include "ranges.h"                     // Measure for range of each file
+#ifndef __BATCH_H__
+#define __BATCH_H__
+
+// Define constants
+#define BATCH_LIST_PREFIX               '@'         // Argument naming a file with list of paths
+#define BATCH_MAX_PATH                  4096        // Longest path of input or output file
+#define BATCH_EXTENSION_TEXT            ".txt"      // Extensions of output files by output kind
+#define BATCH_EXTENSION_JSON            ".json"
+#define BATCH_EXTENSION_CSV             ".csv"
+#define BATCH_EXTENSION_BINARY          ".bin"
+
+// Batch shared by all workers
+typedef struct batch {
+    char** paths;                       // Input paths
+    size_t count;                       // Number of input paths
+    volatile long next;                 // Next path to be taken by a worker
+    int* results;                       // Result of each path (0 or error code)
+    char** names;                       // Output name of each path (without extension)
+    const char* directory;              // Output directory
+    const dump_format_t* format;        // Line format
+    const dump_options_t* options;      // Dump options
+    const range_spec_t* range;          // Range dumped of each file (NULL means whole file)
+} batch_t;
+
+// Declare functions
+int dump_batch(
+    char** args,
+    size_t count,
+    const char* directory,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_spec_t* range,
+    unsigned int workers
+);      // Dump each file into its own output file in given directory
+
+#endif
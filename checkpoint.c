@@ -0,0 +1,296 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: checkpoint.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <io.h>
+#include <windows.h>
+
+// Local definitions
+#include "checkpoint.h"
+#include "dumps.h"
+#include "records.h"
+#include "checksum.h"
+#include "reuse.h"
+#include "device.h"
+#include "info.h"
+
+// Split output file path from optional resume modifier
+bool checkpoint_parse(char* string, bool* resume) {
+    size_t length = strlen(string);
+    size_t modifier = sizeof(CHECKPOINT_RESUME) - 1;
+
+    // Path may contain a colon of its own (drive letter), only the modifier at the end is taken
+    *resume = length > modifier && strcmp(string + length - modifier, CHECKPOINT_RESUME) == 0;
+    if (*resume)
+        string[length - modifier] = 0;
+
+    return string[0] != 0;
+}
+
+// Load state file of the same dump - static function
+static bool load_state(const char* path, const checkpoint_t* expected, checkpoint_t* state) {
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    bool valid = fread(state, sizeof(checkpoint_t), 1, file) == 1
+        && memcmp(state->magic, expected->magic, sizeof(state->magic)) == 0
+        && state->probe == expected->probe
+        && state->input == expected->input
+        && state->fsize == expected->fsize
+        && state->offset == expected->offset
+        && state->endoffset == expected->endoffset
+        && state->verbose == expected->verbose
+        && state->checksum == expected->checksum
+        && state->checksum_block == expected->checksum_block
+        && state->position >= state->offset
+        && state->position <= state->endoffset
+        && state->sample_length <= state->position - state->offset;
+
+    fclose(file);
+    return valid;
+}
+
+// Check that input still holds the data dumped before the checkpoint - static function
+static int verify_input(FILE* file, size_t alignment, const checkpoint_t* state) {
+    ubyte_t* sample = malloc((state->sample_length > 0) ? (size_t)state->sample_length : 1);
+    if (!sample)
+        return ENOMEM;
+
+    // Last chunk dumped before the checkpoint is compared by its hash
+    int retcode = input_seek(file, alignment, (size_t)(state->position - state->sample_length));
+    if (retcode == 0 && fread(sample, BYTE_SIZE, (size_t)state->sample_length, file) < state->sample_length)
+        retcode = (errno != 0) ? errno : EIO;
+    if (retcode == 0 && checksum_once(CHECKSUM_XXH64, sample, (size_t)state->sample_length) != state->sample_hash)
+        retcode = EINVAL;
+
+    free(sample);
+    return retcode;
+}
+
+// Record state of dump reached so far - static function
+static bool save_state(const char* path, const char* temp, checkpoint_t* checkpoint, const dump_state_t* state, FILE* out, const ubyte_t* sample, size_t sample_length) {
+    // Everything dumped so far goes to disk before the state describing it
+    if (fflush(out) != 0 || _commit(_fileno(out)) != 0)
+        return false;
+
+    checkpoint->position = state->position;
+    checkpoint->sample_length = sample_length;
+    checkpoint->sample_hash = checksum_once(CHECKSUM_XXH64, sample, sample_length);
+    checkpoint->output_size = (uqword_t)_ftelli64(out);
+    checkpoint->block_start = state->block_start;
+    checkpoint->block_count = state->block_count;
+    checkpoint->line_repeat = state->line_repeat;
+    checkpoint->has_previous = state->has_previous;
+    memcpy(checkpoint->previous, state->previous, sizeof(checkpoint->previous));
+    checkpoint->total_sum = state->total_sum;
+    checkpoint->block_sum = state->block_sum;
+
+    // State file is written aside and replaces the previous one when complete
+    FILE* file = fopen(temp, "wb");
+    bool failed = !file || fwrite(checkpoint, sizeof(checkpoint_t), 1, file) != 1;
+    if (file && fclose(file) != 0)
+        failed = true;
+
+    return !failed && MoveFileExA(temp, path, MOVEFILE_REPLACE_EXISTING);
+}
+
+// Dump range of a file into output file, recording state file every CHECKPOINT_INTERVAL bytes
+int checkpoint_dump(
+    FILE* file,
+    const char* path,
+    const char* target,
+    bool resume,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t fsize,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    char state_path[CHECKPOINT_MAX_PATH], state_temp[CHECKPOINT_MAX_PATH];
+    int written = snprintf(state_path, sizeof(state_path), "%s%s", target, CHECKPOINT_EXTENSION);
+    snprintf(state_temp, sizeof(state_temp), "%s%s%s", target, CHECKPOINT_EXTENSION, CHECKPOINT_TEMP_EXTENSION);
+
+    if (written < 0 || (size_t)written + sizeof(CHECKPOINT_TEMP_EXTENSION) > sizeof(state_temp)) {
+        // State file path would be too long
+        errno = ENAMETOOLONG;
+        print_file_error("Output file couldn\'t be created");
+
+        return ENAMETOOLONG;
+    }
+
+    // Tables of renderers are used by probe already
+    dump_prepare();
+    record_prepare();
+
+    // Dump this state file describes
+    checkpoint_t checkpoint, previous;
+    memset(&checkpoint, 0, sizeof(checkpoint));
+    memcpy(checkpoint.magic, CHECKPOINT_MAGIC, sizeof(checkpoint.magic));
+    checkpoint.probe = reuse_probe(format, options, get_offset_digits(endoffset));
+    checkpoint.input = checksum_once(CHECKSUM_XXH64, (const unsigned char*)path, strlen(path));
+    checkpoint.fsize = fsize;
+    checkpoint.offset = offset;
+    checkpoint.endoffset = endoffset;
+    checkpoint.verbose = options->verbose;
+    checkpoint.checksum = (ubyte_t)options->checksum;
+    checkpoint.checksum_block = options->checksum_block;
+
+    bool binary = options->output == OUTPUT_BINARY;
+    FILE* out;
+    if (resume) {
+        // Output is cut back to the last checkpoint
+        if (!load_state(state_path, &checkpoint, &previous)) {
+            print_error("No checkpoint of this dump was found, it has to be started again without :resume");
+
+            return ENOENT;
+        }
+
+        // Dump of different data must not be continued (size of a raw volume never changes)
+        int error = verify_input(file, options->alignment, &previous);
+        if (error == EINVAL) {
+            print_error("Input file changed since the last checkpoint, it has to be started again without :resume");
+
+            return EINVAL;
+        }
+        if (error == ENOMEM) {
+            print_error_memory("Out of memory");
+
+            return ENOMEM;
+        }
+        if (error != 0) {
+            errno = error;
+            print_file_error("An error occured while file contents output");
+
+            return error;
+        }
+
+        out = fopen(target, (binary) ? "r+b" : "r+");
+        if (!out) {
+            print_file_error("Output file couldn\'t be opened");
+
+            return errno;
+        }
+
+        _fseeki64(out, 0, SEEK_END);
+        if ((uqword_t)_ftelli64(out) < previous.output_size || _chsize_s(_fileno(out), (long long)previous.output_size) != 0) {
+            // Output lost data written before the checkpoint
+            fclose(out);
+            print_error("Output file is shorter than its last checkpoint, it has to be started again without :resume");
+
+            return EIO;
+        }
+        _fseeki64(out, (long long)previous.output_size, SEEK_SET);
+    }
+    else {
+        // Stale state file of an earlier dump must not outlive the output it describes
+        remove(state_path);
+
+        out = fopen(target, (binary) ? "wb" : "w");
+        if (!out) {
+            print_file_error("Output file couldn\'t be created");
+
+            return errno;
+        }
+
+        if (options->output != OUTPUT_TEXT)
+            record_start(out, options->output, options->checksum);
+    }
+
+    // Chunks of whole lines leave no incomplete line behind at a checkpoint
+    size_t chunk_size = options->chunk_size - options->chunk_size % options->width;
+    ubyte_t* chunk = malloc(chunk_size);
+    dump_state_t state;
+
+    if (!chunk || !dump_init(&state, format, options, out, offset, endoffset)) {
+        // Not enough memory for buffers
+        free(chunk);
+        fclose(out);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    if (resume) {
+        // Continue where the last checkpoint left off
+        state.position = (size_t)previous.position;
+        state.block_start = (size_t)previous.block_start;
+        state.block_count = (size_t)previous.block_count;
+        state.line_repeat = previous.line_repeat != 0;
+        state.has_previous = previous.has_previous != 0;
+        memcpy(state.previous, previous.previous, sizeof(state.previous));
+        state.total_sum = previous.total_sum;
+        state.block_sum = previous.block_sum;
+        *position = state.position;
+
+        input_seek(file, options->alignment, *position);
+        fprintf(stderr, "Resumed at offset %llx\n", (unsigned long long)*position);
+    }
+
+    int retcode = 0;
+    size_t last = *position;
+    while (*position < endoffset) {
+        // Read next chunk of the range
+        size_t count = (endoffset - *position < chunk_size) ? endoffset - *position : chunk_size;
+        size_t successfully_read = fread(chunk, BYTE_SIZE, count, file);
+
+        dump_feed(&state, chunk, successfully_read);
+        *position += successfully_read;
+
+        if (successfully_read < count) {
+            // An error occured while reading file, the last checkpoint stays for resuming
+            retcode = (errno != 0) ? errno : EIO;
+            dump_flush(&state);
+            free(state.buffer);
+            break;
+        }
+
+        if (*position - last >= CHECKPOINT_INTERVAL && *position < endoffset) {
+            // Record state after whole lines
+            dump_flush(&state);
+            if (!save_state(state_path, state_temp, &checkpoint, &state, out, chunk, successfully_read)) {
+                retcode = (errno != 0) ? errno : EIO;
+                free(state.buffer);
+                break;
+            }
+            last = *position;
+        }
+    }
+
+    if (retcode == 0)
+        dump_end(&state);
+    free(chunk);
+
+    if (fclose(out) != 0 && retcode == 0)
+        // Write errors (such as full disk) show up when the output is closed
+        retcode = errno;
+
+    if (retcode != 0) {
+        errno = retcode;
+        print_file_error("An error occured while file contents output");
+
+        return retcode;
+    }
+
+    // Complete dump has nothing to resume
+    remove(state_path);
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: checkpoint.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for dump format, options and state
+#include "checksum.h"                   // Measure for checksum state
+#ifndef __CHECKPOINT_H__
+#define __CHECKPOINT_H__
+
+// Define constants
+#define CHECKPOINT_INTERVAL             268435456   // Input bytes dumped between checkpoints
+#define CHECKPOINT_MAGIC                "HDXCKP03"  // First bytes of state file
+#define CHECKPOINT_EXTENSION            ".ckpt"     // State file is named after the output file
+#define CHECKPOINT_TEMP_EXTENSION       ".tmp"      // New state file replaces the old one when complete
+#define CHECKPOINT_RESUME               ":resume"   // Modifier continuing from the last checkpoint (as given on command line)
+#define CHECKPOINT_MAX_PATH             4096        // Longest path of output file and its state file
+
+// State file (everything a dump needs to continue byte-identically)
+typedef struct checkpoint {
+    char magic[8];                      // CHECKPOINT_MAGIC
+    uqword_t probe;                     // Hash of probe lines rendered by the display (changes with any display option)
+    uqword_t input;                     // Hash of input path
+    uqword_t fsize;                     // Input size
+    uqword_t offset;                    // Initial offset
+    uqword_t endoffset;                 // End offset
+    uqword_t checksum_block;            // Checksum block size (output options the probe doesn't cover)
+    uqword_t position;                  // Input dumped so far (whole lines)
+    uqword_t sample_length;             // Input bytes just before position (last chunk dumped)
+    uqword_t sample_hash;               // Hash of these bytes (input must not change between runs)
+    uqword_t output_size;               // Output written so far
+    uqword_t block_start;               // Offset of current checksum block
+    uqword_t block_count;               // Bytes in current checksum block
+    ubyte_t line_repeat;                // Repeating line (asterisk already written)
+    ubyte_t has_previous;               // Previous full line is valid
+    ubyte_t verbose;                    // Repeating lines are displayed (not squeezed)
+    ubyte_t checksum;                   // Checksum algorithm
+    ubyte_t reserved[4];                // Padding (zero)
+    ubyte_t previous[DUMP_MAX_LINE_WIDTH];  // Previous full line
+    checksum_t total_sum;               // Checksum of all data so far
+    checksum_t block_sum;               // Checksum of current block
+} checkpoint_t;
+
+// Declare functions
+bool checkpoint_parse(
+    char* string,
+    bool* resume
+);      // Split output file path from optional resume modifier
+int checkpoint_dump(
+    FILE* file,
+    const char* path,
+    const char* target,
+    bool resume,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t fsize,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+);      // Dump range of a file into output file, recording state file every CHECKPOINT_INTERVAL bytes
+
+#endif
@@ -0,0 +1,349 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: checksum.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// CRC instructions (SSE 4.2 on x86, CRC extension on ARM64)
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#include <nmmintrin.h>
+#define CRC32C_HARDWARE_X86
+#elif defined(_M_ARM64)
+#include <intrin.h>
+#define CRC32C_HARDWARE_ARM
+#endif
+
+// Local definitions
+#include "checksum.h"
+
+// Slicing-by-8 tables for processors without CRC instructions
+static unsigned int crc32c_tables[CRC32C_TABLES][256];
+static bool crc32c_tables_ready = false;
+
+// Hardware support (-1 means not detected yet)
+static int crc32c_hardware_support = -1;
+
+// Fill CRC-32C tables - static function
+static void crc32c_init_tables(void) {
+    for (unsigned int i = 0; i < 256; ++i) {
+        // Plain bytewise table
+        unsigned int crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : crc >> 1;
+        crc32c_tables[0][i] = crc;
+    }
+
+    for (unsigned int i = 0; i < 256; ++i) {
+        // Each next table advances the CRC by one more zero byte
+        for (int table = 1; table < CRC32C_TABLES; ++table)
+            crc32c_tables[table][i] = (crc32c_tables[table - 1][i] >> 8) ^ crc32c_tables[0][crc32c_tables[table - 1][i] & 0xff];
+    }
+
+    crc32c_tables_ready = true;
+}
+
+// Detect CRC instructions - static function
+static bool crc32c_detect_hardware(void) {
+#if defined(CRC32C_HARDWARE_X86)
+    // SSE 4.2 is reported in bit 20 of ECX of the first CPUID leaf
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#elif defined(CRC32C_HARDWARE_ARM)
+    // CRC extension is mandatory for 64-bit ARM Windows
+    return true;
+#else
+    return false;
+#endif
+}
+
+// CRC-32C using slicing-by-8 tables - static function
+static unsigned int crc32c_software(unsigned int crc, const unsigned char* data, size_t count) {
+    while (count >= 8) {
+        // Process 8 bytes with a single lookup in each table
+        unsigned int one, two;
+        memcpy(&one, data, sizeof(one));
+        memcpy(&two, data + 4, sizeof(two));
+        one ^= crc;
+
+        crc = crc32c_tables[7][one & 0xff] ^ crc32c_tables[6][(one >> 8) & 0xff] ^
+              crc32c_tables[5][(one >> 16) & 0xff] ^ crc32c_tables[4][one >> 24] ^
+              crc32c_tables[3][two & 0xff] ^ crc32c_tables[2][(two >> 8) & 0xff] ^
+              crc32c_tables[1][(two >> 16) & 0xff] ^ crc32c_tables[0][two >> 24];
+
+        data += 8;
+        count -= 8;
+    }
+
+    // Remaining bytes one by one
+    while (count-- > 0)
+        crc = crc32c_tables[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+#if defined(CRC32C_HARDWARE_X86) || defined(CRC32C_HARDWARE_ARM)
+// CRC-32C using processor instructions - static function
+static unsigned int crc32c_hardware(unsigned int crc, const unsigned char* data, size_t count) {
+#if defined(_M_X64) || defined(_M_ARM64)
+    while (count >= 8) {
+        // Full 8 bytes at once
+        unsigned long long value;
+        memcpy(&value, data, sizeof(value));
+#if defined(_M_X64)
+        crc = (unsigned int)_mm_crc32_u64(crc, value);
+#else
+        crc = __crc32cd(crc, value);
+#endif
+        data += 8;
+        count -= 8;
+    }
+#endif
+
+    while (count >= 4) {
+        // 4 bytes at once
+        unsigned int value;
+        memcpy(&value, data, sizeof(value));
+#if defined(CRC32C_HARDWARE_X86)
+        crc = _mm_crc32_u32(crc, value);
+#else
+        crc = __crc32cw(crc, value);
+#endif
+        data += 4;
+        count -= 4;
+    }
+
+    while (count-- > 0) {
+        // Remaining bytes one by one
+#if defined(CRC32C_HARDWARE_X86)
+        crc = _mm_crc32_u8(crc, *data++);
+#else
+        crc = __crc32cb(crc, *data++);
+#endif
+    }
+
+    return crc;
+}
+#endif
+
+// Prepare CRC-32C implementation on first use - static function
+static void crc32c_prepare(void) {
+    if (crc32c_hardware_support < 0)
+        crc32c_hardware_support = crc32c_detect_hardware();
+    if (!crc32c_hardware_support && !crc32c_tables_ready)
+        crc32c_init_tables();
+}
+
+// Update CRC-32C register - static function
+static unsigned int crc32c_update(unsigned int crc, const unsigned char* data, size_t count) {
+#if defined(CRC32C_HARDWARE_X86) || defined(CRC32C_HARDWARE_ARM)
+    if (crc32c_hardware_support)
+        return crc32c_hardware(crc, data, count);
+#endif
+    return crc32c_software(crc, data, count);
+}
+
+// Rotate left - static function
+static unsigned long long rotate_left(unsigned long long value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Read 64-bit little-endian value - static function
+static unsigned long long read_qword(const unsigned char* data) {
+    unsigned long long value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Read 32-bit little-endian value - static function
+static unsigned long long read_dword(const unsigned char* data) {
+    unsigned int value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// xxHash64 accumulator round - static function
+static unsigned long long xxh64_round(unsigned long long accumulator, unsigned long long input) {
+    accumulator += input * XXH64_PRIME_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * XXH64_PRIME_1;
+}
+
+// xxHash64 accumulator merge - static function
+static unsigned long long xxh64_merge(unsigned long long hash, unsigned long long accumulator) {
+    hash ^= xxh64_round(0, accumulator);
+    return hash * XXH64_PRIME_1 + XXH64_PRIME_4;
+}
+
+// xxHash64 full stripes - static function
+static const unsigned char* xxh64_stripes(unsigned long long* accumulators, const unsigned char* data, size_t count) {
+    const unsigned char* end = data + count - count % XXH64_STRIPE;
+
+    // Four independent lanes of 8 bytes each
+    unsigned long long a = accumulators[0], b = accumulators[1], c = accumulators[2], d = accumulators[3];
+
+    for (; data < end; data += XXH64_STRIPE) {
+        a = xxh64_round(a, read_qword(data));
+        b = xxh64_round(b, read_qword(data + 8));
+        c = xxh64_round(c, read_qword(data + 16));
+        d = xxh64_round(d, read_qword(data + 24));
+    }
+
+    accumulators[0] = a;
+    accumulators[1] = b;
+    accumulators[2] = c;
+    accumulators[3] = d;
+
+    return data;
+}
+
+// Get algorithm from its name
+int checksum_parse(const char* name) {
+    if (strcmp(name, CHECKSUM_NAME_CRC32C) == 0)
+        return CHECKSUM_CRC32C;
+    if (strcmp(name, CHECKSUM_NAME_XXH64) == 0)
+        return CHECKSUM_XXH64;
+
+    return CHECKSUM_NONE;
+}
+
+// Get name of algorithm
+const char* checksum_name(int algorithm) {
+    return (algorithm == CHECKSUM_XXH64) ? CHECKSUM_NAME_XXH64 : CHECKSUM_NAME_CRC32C;
+}
+
+// Get number of hexadecimal digits of a checksum
+size_t checksum_digits(int algorithm) {
+    return (algorithm == CHECKSUM_XXH64) ? 16 : 8;
+}
+
+// Start a new checksum
+void checksum_init(checksum_t* checksum, int algorithm) {
+    checksum->algorithm = algorithm;
+
+    if (algorithm == CHECKSUM_CRC32C) {
+        crc32c_prepare();
+        checksum->crc = CRC32C_INITIAL;
+    }
+
+    // Seed is always zero
+    checksum->accumulators[0] = XXH64_PRIME_1 + XXH64_PRIME_2;
+    checksum->accumulators[1] = XXH64_PRIME_2;
+    checksum->accumulators[2] = 0;
+    checksum->accumulators[3] = 0 - XXH64_PRIME_1;
+    checksum->total = 0;
+    checksum->stripe_count = 0;
+}
+
+// Add data to checksum
+void checksum_update(checksum_t* checksum, const unsigned char* data, size_t count) {
+    if (checksum->algorithm == CHECKSUM_CRC32C) {
+        checksum->crc = crc32c_update(checksum->crc, data, count);
+        return;
+    }
+
+    checksum->total += count;
+
+    if (checksum->stripe_count > 0) {
+        // Complete stripe left over from previous update
+        size_t take = XXH64_STRIPE - checksum->stripe_count;
+        if (take > count)
+            take = count;
+
+        memcpy(checksum->stripe + checksum->stripe_count, data, take);
+        checksum->stripe_count += take;
+        data += take;
+        count -= take;
+
+        if (checksum->stripe_count < XXH64_STRIPE)
+            return;     // Still incomplete
+
+        xxh64_stripes(checksum->accumulators, checksum->stripe, XXH64_STRIPE);
+        checksum->stripe_count = 0;
+    }
+
+    // Full stripes straight from the data, keep the rest for later
+    const unsigned char* rest = xxh64_stripes(checksum->accumulators, data, count);
+    checksum->stripe_count = data + count - rest;
+    memcpy(checksum->stripe, rest, checksum->stripe_count);
+}
+
+// Get checksum value of data added so far
+unsigned long long checksum_final(const checksum_t* checksum) {
+    if (checksum->algorithm == CHECKSUM_CRC32C)
+        return checksum->crc ^ CRC32C_INITIAL;
+
+    const unsigned long long* acc = checksum->accumulators;
+    unsigned long long hash;
+
+    if (checksum->total >= XXH64_STRIPE) {
+        // Converge all four lanes
+        hash = rotate_left(acc[0], 1) + rotate_left(acc[1], 7) + rotate_left(acc[2], 12) + rotate_left(acc[3], 18);
+        hash = xxh64_merge(hash, acc[0]);
+        hash = xxh64_merge(hash, acc[1]);
+        hash = xxh64_merge(hash, acc[2]);
+        hash = xxh64_merge(hash, acc[3]);
+    }
+    else
+        // Lanes weren't used at all
+        hash = acc[2] + XXH64_PRIME_5;
+
+    hash += checksum->total;
+
+    // Consume the incomplete stripe
+    const unsigned char* data = checksum->stripe;
+    size_t count = checksum->stripe_count;
+
+    for (; count >= 8; data += 8, count -= 8) {
+        hash ^= xxh64_round(0, read_qword(data));
+        hash = rotate_left(hash, 27) * XXH64_PRIME_1 + XXH64_PRIME_4;
+    }
+    if (count >= 4) {
+        hash ^= read_dword(data) * XXH64_PRIME_1;
+        hash = rotate_left(hash, 23) * XXH64_PRIME_2 + XXH64_PRIME_3;
+        data += 4;
+        count -= 4;
+    }
+    for (; count > 0; ++data, --count) {
+        hash ^= *data * XXH64_PRIME_5;
+        hash = rotate_left(hash, 11) * XXH64_PRIME_1;
+    }
+
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= XXH64_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= XXH64_PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+// Get checksum of a single piece of data
+unsigned long long checksum_once(int algorithm, const unsigned char* data, size_t count) {
+    if (algorithm == CHECKSUM_CRC32C) {
+        // CRC doesn't need the whole state
+        crc32c_prepare();
+        return crc32c_update(CRC32C_INITIAL, data, count) ^ CRC32C_INITIAL;
+    }
+
+    checksum_t checksum;
+    checksum_init(&checksum, algorithm);
+    checksum_update(&checksum, data, count);
+    return checksum_final(&checksum);
+}
@@ -0,0 +1,81 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: checksum.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stddef.h>                     // Measure for size type
+#ifndef __CHECKSUM_H__
+#define __CHECKSUM_H__
+
+// Checksum algorithms
+#define CHECKSUM_NONE                   0           // No checksum
+#define CHECKSUM_CRC32C                 1           // CRC-32C (Castagnoli)
+#define CHECKSUM_XXH64                  2           // xxHash64 with zero seed
+
+// Algorithm names (as given on command line)
+#define CHECKSUM_NAME_CRC32C            "crc32c"
+#define CHECKSUM_NAME_XXH64             "xxh64"
+
+// CRC-32C constants
+#define CRC32C_POLYNOMIAL               0x82f63b78  // Reflected Castagnoli polynomial
+#define CRC32C_INITIAL                  0xffffffff
+#define CRC32C_TABLES                   8           // Slicing-by-8 fallback
+
+// xxHash64 constants
+#define XXH64_PRIME_1                   0x9e3779b185ebca87ULL
+#define XXH64_PRIME_2                   0xc2b2ae3d27d4eb4fULL
+#define XXH64_PRIME_3                   0x165667b19e3779f9ULL
+#define XXH64_PRIME_4                   0x85ebca77c2b2ae63ULL
+#define XXH64_PRIME_5                   0x27d4eb2f165667c5ULL
+#define XXH64_STRIPE                    32          // Bytes consumed by one round of accumulators
+
+// Running checksum state
+typedef struct checksum {
+    int algorithm;                      // Checksum algorithm
+    unsigned int crc;                   // CRC-32C register
+    unsigned long long accumulators[4]; // xxHash64 accumulators
+    unsigned long long total;           // xxHash64 total length
+    unsigned char stripe[XXH64_STRIPE]; // xxHash64 incomplete stripe
+    size_t stripe_count;                // Bytes in incomplete stripe
+} checksum_t;
+
+// Declare functions
+int checksum_parse(
+    const char* name
+);      // Get algorithm from its name (CHECKSUM_NONE if unknown)
+const char* checksum_name(
+    int algorithm
+);      // Get name of algorithm
+size_t checksum_digits(
+    int algorithm
+);      // Get number of hexadecimal digits of a checksum
+void checksum_init(
+    checksum_t* checksum,
+    int algorithm
+);      // Start a new checksum
+void checksum_update(
+    checksum_t* checksum,
+    const unsigned char* data,
+    size_t count
+);      // Add data to checksum
+unsigned long long checksum_final(
+    const checksum_t* checksum
+);      // Get checksum value of data added so far
+unsigned long long checksum_once(
+    int algorithm,
+    const unsigned char* data,
+    size_t count
+);      // Get checksum of a single piece of data
+
+#endif
@@ -0,0 +1,82 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: device.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <io.h>
+#include <windows.h>
+#include <winioctl.h>
+
+// Local definitions
+#include "device.h"
+
+// Get length and sector size of raw device - static function
+static bool query_device(FILE* file, size_t* size, size_t* sector) {
+    HANDLE handle = (HANDLE)_get_osfhandle(_fileno(file));
+    GET_LENGTH_INFORMATION length;
+    DISK_GEOMETRY geometry;
+    DWORD returned;
+
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    // Regular files don't answer disk requests
+    if (!DeviceIoControl(handle, IOCTL_DISK_GET_LENGTH_INFO, NULL, 0, &length, sizeof(length), &returned, NULL))
+        return false;
+
+    *size = (size_t)length.Length.QuadPart;
+    *sector = DEVICE_DEFAULT_SECTOR;
+    if (DeviceIoControl(handle, IOCTL_DISK_GET_DRIVE_GEOMETRY, NULL, 0, &geometry, sizeof(geometry), &returned, NULL) && geometry.BytesPerSector > 0)
+        *sector = geometry.BytesPerSector;
+
+    return true;
+}
+
+// Get size of input file or raw device
+size_t input_prepare(FILE* file, size_t* alignment) {
+    size_t size, sector;
+
+    if (query_device(file, &size, &sector)) {
+        // Raw device reads whole sectors at sector aligned offsets only: stream buffer of one sector
+        // keeps short reads aligned, longer reads go to device directly in whole sectors
+        setvbuf(file, NULL, _IOFBF, sector);
+        *alignment = sector;
+
+        return size;
+    }
+
+    // Seeking to the end of a device doesn't tell its size, of a regular file it does
+    *alignment = 1;
+    _fseeki64(file, 0, SEEK_END);
+    return (size_t)_ftelli64(file);
+}
+
+// Set position of input
+int input_seek(FILE* file, size_t alignment, size_t offset) {
+    // Raw device is positioned at the sector boundary
+    size_t skip = (alignment > 1) ? offset % alignment : 0;
+
+    if (_fseeki64(file, (long long)(offset - skip), SEEK_SET) != 0)
+        return errno;
+
+    // Bytes before offset come from the sector held in stream buffer
+    for (; skip > 0; --skip) {
+        if (fgetc(file) == EOF)
+            return (errno != 0) ? errno : EIO;
+    }
+
+    return 0;
+}
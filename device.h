@@ -0,0 +1,35 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: device.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#ifndef __DEVICE_H__
+#define __DEVICE_H__
+
+// Define constants
+#define DEVICE_DEFAULT_SECTOR           512         // Sector size assumed when device doesn't report one
+
+// Declare functions
+size_t input_prepare(
+    FILE* file,
+    size_t* alignment
+);      // Get size of input file or raw device (\\.\PhysicalDrive0, \\.\C:), device reads are set up to stay sector aligned
+int input_seek(
+    FILE* file,
+    size_t alignment,
+    size_t offset
+);      // Set position of input, raw device is read from the sector boundary up to offset
+
+#endif
@@ -9,7 +9,7 @@
  * File: dumps.c
  *
  *-------------------------------------------------
- * Made by Marek Polek (Polda18)
+ * Made by Marek Poláček (Polda18)
  **************************************************/
 
 // Global definitions
@@ -20,923 +20,1302 @@
 #include <direct.h>
 #include <errno.h>
 
+// Byte swapping instructions (SSSE3 on x86, NEON on ARM64)
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#include <tmmintrin.h>
+#define SWAP_VECTOR_X86
+#elif defined(_M_ARM64)
+#include <arm_neon.h>
+#define SWAP_VECTOR_ARM
+#endif
+
 // Local definitions
 #include "dumps.h"
 #include "info.h"
+#include "checksum.h"
+#include "floats.h"
+#include "records.h"
+
+// Hexadecimal digits
+static const char hex_digits[] = "0123456789abcdef";
+
+// Column digits of typed display for unit sizes of 1, 2, 4 and 8 bytes
+static const size_t type_hex_digits[] = { 2, 4, 8, 16 };
+static const size_t type_unsigned_digits[] = { 3, 5, 10, 20 };
+static const size_t type_signed_digits[] = { 4, 6, 11, 20 };       // Including sign
+
+// SSSE3 support (-1 means not detected yet)
+static int swap_vector_support = -1;
+
+// Character cells of byte character display (filled on first use)
+static char char_cells[256][CHAR_BYTE_CELL];
+static bool char_cells_ready = false;
+
+// Fill character cells - static function
+static void init_char_cells(void) {
+    char cell[16];      // Formatting space (cell itself is never longer than CHAR_BYTE_CELL)
+
+    for (int value = 0; value < 256; ++value) {
+        if (value >= ASCII_LOWEST && value <= ASCII_HIGHEST || value >= ASCII_DOS_CP_BEGIN) {
+            // Byte is printable ASCII character or equals a value in DOS codepage
+            sprintf(cell, CHAR_BYTE_FORMAT_PRINTABLE, value);
+            memcpy(char_cells[value], cell, CHAR_BYTE_CELL);
+            continue;
+        }
 
-// Print offset - static function
-static void print_offset(FILE* file, size_t ndigits, size_t position) {
-    // Construct string format for offset display
-    char format[100];                       // Init format buffer
-    sprintf(format, "%%0%lux", ndigits);    // Get format for offset
+        switch (value) {
+            // Is not printable nor in DOS codepage
+        case CHAR_BYTE_VALUE_NULL:
+            // Null byte
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_NULL);
+            break;
+        case CHAR_BYTE_VALUE_BELL:
+            // Beep
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_BELL);
+            break;
+        case CHAR_BYTE_VALUE_BS:
+            // Backspace
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_BS);
+            break;
+        case CHAR_BYTE_VALUE_TAB:
+            // Tabulator
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_TAB);
+            break;
+        case CHAR_BYTE_VALUE_LF:
+            // Line feed
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_LF);
+            break;
+        case CHAR_BYTE_VALUE_VT:
+            // Vertical tab
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_VT);
+            break;
+        case CHAR_BYTE_VALUE_FF:
+            // Form feed
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_FF);
+            break;
+        case CHAR_BYTE_VALUE_CR:
+            // Carriage return
+            strcpy(cell, CHAR_BYTE_FORMAT_ESCAPE_CR);
+            break;
+        default:
+            // Another value that doesn't fall in standard escape sequence
+            sprintf(cell, CHAR_BYTE_FORMAT_OCTAL, value);
+        }
 
-    // Return offset hexadecimal value
-    fprintf(stdout, format, position);
-}
+        memcpy(char_cells[value], cell, CHAR_BYTE_CELL);
+    }
 
-// Calculate number of digits - static function
-static size_t get_offset_digits(size_t number) {
-    // Get number of digits for offset display
-    size_t ndigits = MIN_OFFSET_DIGITS;     // Init number of digits - bare minimum is 7
-    register size_t num_copy = number;      // Init operations on given offset value
+    char_cells_ready = true;
+}
 
-    // For number greater or equal to 0x10000000 add appropriate number of digits
-    while(num_copy >= OVERFLOW_VALUE) {
-        num_copy /= 16;     // Hexadecimal division
-        ++ndigits;          // Count the digits
+// Render zero-filled number - static function
+static __forceinline char* put_number(char* out, uqword_t value, size_t digits, unsigned int base) {
+    // Digits are filled from the right, shifts are used for power of two bases
+    switch (base) {
+    case 16:
+        for (size_t i = digits; i > 0; --i, value >>= 4)
+            out[i - 1] = hex_digits[value & 0xf];
+        break;
+    case 8:
+        for (size_t i = digits; i > 0; --i, value >>= 3)
+            out[i - 1] = hex_digits[value & 0x7];
+        break;
+    case 2:
+        for (size_t i = digits; i > 0; --i, value >>= 1)
+            out[i - 1] = hex_digits[value & 0x1];
+        break;
+    default:
+        for (size_t i = digits; i > 0; --i, value /= base)
+            out[i - 1] = hex_digits[value % base];
     }
 
-    // Return number of digits
-    return ndigits;
+    return out + digits;
 }
 
-// Dump byte hex
-int dump_plain_hex(
-    FILE* file,
-    bool verbose,
-    size_t offset,
-    size_t* position,
-    size_t endoffset
+// Load single unit in system endianness - static function
+static __forceinline uqword_t load_unit(const ubyte_t* data, size_t available, size_t unit) {
+    // Incomplete unit at the end of data is filled up with zero bytes
+    ubyte_t bytes[sizeof(uqword_t)] = { 0 };
+    memcpy(bytes, data, (available < unit) ? available : unit);
+
+    switch (unit) {
+    case sizeof(uword_t): {
+        uword_t value;
+        memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case sizeof(udword_t): {
+        udword_t value;
+        memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case sizeof(uqword_t): {
+        uqword_t value;
+        memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    default:
+        return bytes[0];
+    }
+}
+
+// Render numeric columns - static function
+static __forceinline char* render_units(
+    const dump_format_t* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
 ) {
     // Format:
-    // "%07x" or greater for offset at the beginning (aligned to 0x10 for value less than end of file)
-    // 1 space
-    // "%04x" for each valid 2 bytes of input data (aligned as 8 16bit values, separated by 1 space)
-    // If end of file reached, only offset is printed
-
-    // Calculate number of digits based on ending offset
-    size_t ndigits = get_offset_digits(endoffset);
-
-    // Initialize buffers (16 bytes, arranged as 8 2-byte values)
-    uword_t buffer_current[WORD_ARRAY_NUM];
-    uword_t buffer_previous[WORD_ARRAY_NUM];
-
-    ubyte_t remainder = 0;              // Save up for last remaining byte
-
-    bool data_repeat = false;           // Repeating data
-    bool line_repeat = false;           // Repeating line
-
-    size_t successfully_read = 0;
-    
-    // Print out data in plain 2-byte hexadecimal format
-    do {
-        // Run at least once
-
-        // Check for previous iteration round - full line counts
-        if (successfully_read == WORD_ARRAY_NUM) {
-            // Previously read full 16 bytes -> copy all current buffer into previous one
-            for (int i = 0; i < WORD_ARRAY_NUM; ++i) {
-                buffer_previous[i] = buffer_current[i];
-            }
-        }
-
-        // Read into current buffer -> count number of successful 
-        successfully_read = fread(buffer_current, WORD_SIZE, WORD_ARRAY_NUM, file);
-
-        if ((successfully_read < WORD_ARRAY_NUM) && (ftell(file) < endoffset)) {
-            // An error occured while reading file
-
-            putchar('\n');      // Divide space between data and error message
-            print_file_error("An error occured while file contents output");
-
-            return errno;       // End with specific return code for given error
+    // Leading spaces and zero-filled number for each valid unit of input data
+    // (an incomplete unit at the end is filled up with zero bytes)
+    // or empty spaces for invalid units at the end
+
+    for (size_t i = 0; i < width; i += format->unit) {
+        // Leading spaces of a column
+        memset(out, ' ', format->spaces);
+        out += format->spaces;
+
+        if (i >= count) {
+            // Fill remaining space with white spaces
+            memset(out, ' ', format->digits);
+            out += format->digits;
+            continue;
         }
 
-        // Check for repeating data
-        if (*position > offset) {
-            // If whole 16 bytes have been read, proceed
-
-            // Mark repeating data initial to true
-            data_repeat = true;
-
-            // Iterate through both buffers to find repeating data
-            for (int i = 0; i < successfully_read; ++i) {
-                // If single element is different, next iteration won't matter
-                data_repeat = data_repeat && (buffer_current[i] == buffer_previous[i]);
-            }
+        // Print unit value
+        out = put_number(out, load_unit(data + i, count - i, format->unit), format->digits, format->base);
+    }
 
-            if (!data_repeat)           // If data isn't repeating, line isn't repeating eighter
-                line_repeat = false;
-        }
+    return out;
+}
 
-        // If verbose isn't set and buffers are repeating, then print out single asterisk and skip iteration
-        if (!verbose && data_repeat) {
-            // Check for repeating line
-            if (!line_repeat) {
-                fprintf(stdout, "*\n");     // Print out asterisk
-                line_repeat = true;         // Set repeating line
+// Render binary columns - static function
+static __forceinline char* render_binary(
+    const dump_format_t* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
+) {
+    // Format:
+    // " %08b" for each valid byte of input data
+    // or empty spaces for invalid bytes at the end
+
+    size_t i = 0;
+
+#if defined(SWAP_VECTOR_X86)
+    // Each byte is broadcast to eight lanes, every lane tests one bit (most significant first)
+    // and a set bit turns '0' into '1' (compare gives -1) - SSE2 is always present
+    const __m128i bits = _mm_setr_epi8(
+        (char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+        (char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m128i zeros = _mm_set1_epi8('0');
+
+    for (; i + 8 <= count; i += 8) {
+        // Eight bytes give four vectors of two bytes each
+        __m128i bytes = _mm_loadl_epi64((const __m128i*)(data + i));
+        bytes = _mm_unpacklo_epi8(bytes, bytes);
+        __m128i quads[2] = { _mm_unpacklo_epi16(bytes, bytes), _mm_unpackhi_epi16(bytes, bytes) };
+
+        for (size_t q = 0; q < 2; ++q) {
+            __m128i pairs[2] = { _mm_unpacklo_epi32(quads[q], quads[q]), _mm_unpackhi_epi32(quads[q], quads[q]) };
+
+            for (size_t p = 0; p < 2; ++p) {
+                __m128i digits = _mm_sub_epi8(zeros, _mm_cmpeq_epi8(_mm_and_si128(pairs[p], bits), bits));
+                out[0] = ' ';
+                _mm_storel_epi64((__m128i*)(out + 1), digits);
+                out[BINARY_BYTE_SPACES + BINARY_BYTE_DIGITS] = ' ';
+                _mm_storel_epi64((__m128i*)(out + 2 * BINARY_BYTE_SPACES + BINARY_BYTE_DIGITS), _mm_srli_si128(digits, 8));
+                out += 2 * (BINARY_BYTE_SPACES + BINARY_BYTE_DIGITS);
             }
-
-            *position = ftell(file);        // Get new position
-            continue;                       // Skip iteration
-        }
-        // Data are different or verbose is enabled - proceed
-
-        // Print current position
-        print_offset(file, ndigits, *position);
-
-        // Iterate through current buffer
-        for (int i = 0; i < successfully_read; ++i) {
-            // Iterate through read elements
-            fprintf(stdout, HEX_PLAIN_FORMAT, buffer_current[i]);
-        }
-
-        // Get new position from number of successfuly read bytes
-        *position += successfully_read * WORD_SIZE;
-
-        // Check for last remanining byte in incomplete 16byte data buffer
-        if ((*position == endoffset - BYTE_SIZE) && (successfully_read < 8)) {
-            fseek(file, *position, SEEK_SET);                                   // Reset to last known position
-            successfully_read += fread(&remainder, BYTE_SIZE, 1, file);         // Read single byte
-            fprintf(stdout, HEX_PLAIN_FORMAT, remainder);                       // Print remainder out
-            *position = ftell(file);                                            // Update position to finish iteration
         }
-
-        // Fill remaining space with white space
-        for (int i = successfully_read; i < WORD_ARRAY_NUM; ++i) {
-            fprintf(stdout, "     ");
+    }
+#elif defined(SWAP_VECTOR_ARM)
+    // Each byte is broadcast to eight lanes, every lane tests one bit (most significant first)
+    // and a set bit turns '0' into '1' (test gives all ones)
+    static const ubyte_t bit_lanes[16] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+    const uint8x16_t bits = vld1q_u8(bit_lanes);
+    const uint8x16_t zeros = vdupq_n_u8('0');
+
+    for (; i + 2 <= count; i += 2) {
+        // Two bytes at once
+        uint8x16_t pair = vcombine_u8(vdup_n_u8(data[i]), vdup_n_u8(data[i + 1]));
+        uint8x16_t digits = vsubq_u8(zeros, vtstq_u8(pair, bits));
+        out[0] = ' ';
+        vst1_u8((uint8_t*)(out + 1), vget_low_u8(digits));
+        out[BINARY_BYTE_SPACES + BINARY_BYTE_DIGITS] = ' ';
+        vst1_u8((uint8_t*)(out + 2 * BINARY_BYTE_SPACES + BINARY_BYTE_DIGITS), vget_high_u8(digits));
+        out += 2 * (BINARY_BYTE_SPACES + BINARY_BYTE_DIGITS);
+    }
+#endif
+
+    for (; i < width; ++i) {
+        // Remaining bytes one at a time
+        memset(out, ' ', BINARY_BYTE_SPACES);
+        out += BINARY_BYTE_SPACES;
+
+        if (i >= count) {
+            // Fill remaining space with white spaces
+            memset(out, ' ', BINARY_BYTE_DIGITS);
+            out += BINARY_BYTE_DIGITS;
+            continue;
         }
 
-        // Issue end of line
-        putchar('\n');
-    } while (*position < endoffset);
-
-    // Reached end of file
-    print_offset(file, ndigits, *position);         // Print ending position
-    putchar('\n');                                  // Last line feed
+        out = put_number(out, data[i], BINARY_BYTE_DIGITS, 2);
+    }
 
-    return 0;
+    return out;
 }
 
-// Dump byte octal
-int dump_byte_octal(
-    FILE* file,
-    bool verbose,
-    size_t offset,
-    size_t* position,
-    size_t endoffset
+// Render character columns - static function
+static __forceinline char* render_chars(
+    const dump_format_t* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
 ) {
     // Format:
-    // "%07x" or greater for offset at the beginning (aligned to 0x10 for value less than end of file)
-    // 1 space
-    // "%03o" for each valid byte of input data (aligned as 16 8bit values) (separated by 1 space)
-    // or empty spaces for invalid bytes at the beginning
-    // If end of file reached, only offset is printed
-
-    // Calculate number of digits based on ending offset
-    size_t ndigits = get_offset_digits(endoffset);
+    // "   %c" for each valid byte of input data for printable characters
+    // or "  \\?" where ? is escape sequence for control characters
+    // or " %03o" for other valid values
+    // or empty spaces for invalid bytes at the end
+
+    for (size_t i = 0; i < count; ++i) {
+        // Copy precomputed cell
+        memcpy(out, char_cells[data[i]], CHAR_BYTE_CELL);
+        out += CHAR_BYTE_CELL;
+    }
 
-    // Initialize buffers (16 bytes, arranged as 8 2-byte values)
-    ubyte_t buffer_current[BYTE_ARRAY_NUM];
-    ubyte_t buffer_previous[BYTE_ARRAY_NUM];
+    // Fill remaining space with white spaces
+    memset(out, ' ', (width - count) * CHAR_BYTE_CELL);
+    return out + (width - count) * CHAR_BYTE_CELL;
+}
 
-    bool data_repeat = false;           // Repeating data
-    bool line_repeat = false;           // Repeating line
+// Check if data are plain ASCII - static function
+static __forceinline bool is_ascii(const ubyte_t* data, size_t count) {
+    // High bits of eight bytes are tested at once (with a constant count the loop
+    // is unrolled or turned into vector instructions)
+    uqword_t high = 0;
+    size_t i = 0;
+
+    for (; i + sizeof(uqword_t) <= count; i += sizeof(uqword_t)) {
+        uqword_t bytes;
+        memcpy(&bytes, data + i, sizeof(bytes));
+        high |= bytes;
+    }
 
-    size_t successfully_read = 0;
+    for (; i < count; ++i)
+        high |= data[i];
 
-    // Print out data in 1-byte octal format
-    do {
-        // Run at least once
+    return (high & UTF8_ASCII_MASK) == 0;
+}
 
-        // Check for previous iteration round - full line counts
-        if (successfully_read == BYTE_ARRAY_NUM) {
-            // Previously read full 16 bytes -> copy all current buffer into previous one
-            for (int i = 0; i < BYTE_ARRAY_NUM; ++i) {
-                buffer_previous[i] = buffer_current[i];
-            }
-        }
+// Get length of valid UTF-8 sequence of a printable character (0 if there is none) - static function
+static __forceinline size_t utf8_sequence(const ubyte_t* data, size_t available) {
+    ubyte_t lead = data[0];
+    ubyte_t low = UTF8_CONTINUATION_LOW;        // Bounds of second byte
+    ubyte_t high = UTF8_CONTINUATION_HIGH;
+    size_t length;
+
+    if (lead < UTF8_LEAD_2 || lead > UTF8_LEAD_HIGHEST)
+        return 0;   // ASCII, continuation byte or invalid lead byte
+    else if (lead < UTF8_LEAD_3) {
+        length = 2;
+        if (lead == UTF8_LEAD_2)
+            low = UTF8_PRINTABLE_LOW;   // C1 control characters
+    }
+    else if (lead < UTF8_LEAD_4) {
+        length = 3;
+        if (lead == 0xe0)
+            low = 0xa0;                 // Overlong encodings
+        else if (lead == 0xed)
+            high = 0x9f;                // UTF-16 surrogates
+    }
+    else {
+        length = 4;
+        if (lead == 0xf0)
+            low = 0x90;                 // Overlong encodings
+        else if (lead == UTF8_LEAD_HIGHEST)
+            high = 0x8f;                // Beyond U+10FFFF
+    }
 
-        // Read into current buffer -> count number of successful 
-        successfully_read = fread(buffer_current, BYTE_SIZE, BYTE_ARRAY_NUM, file);
+    if (length > available || data[1] < low || data[1] > high)
+        return 0;   // Sequence is cut off by the end of line or malformed
 
-        if ((successfully_read < BYTE_ARRAY_NUM) && (ftell(file) < endoffset)) {
-            // An error occured while reading file
+    for (size_t i = 2; i < length; ++i) {
+        if (data[i] < UTF8_CONTINUATION_LOW || data[i] > UTF8_CONTINUATION_HIGH)
+            return 0;
+    }
 
-            putchar('\n');      // Divide space between data and error message
-            print_file_error("An error occured while file contents output");
+    return length;
+}
 
-            return errno;       // End with specific return code for given error
+// Render UTF-8 character columns - static function
+static __forceinline char* render_chars_utf8(
+    const dump_format_t* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
+) {
+    // Format:
+    // Same as character columns for ASCII values,
+    // "   ?" where ? is the decoded character in cell of its first byte
+    // and "   \xc2\xb7" (middle dot) in cells of its continuation bytes
+    // or " %03o" for bytes that aren't part of a valid sequence
+
+    if (is_ascii(data, count))
+        // Plain ASCII line is copied from precomputed cells
+        return render_chars(format, out, data, count, width);
+
+    for (size_t i = 0; i < count;) {
+        if (data[i] < ASCII_DOS_CP_BEGIN) {
+            // ASCII value
+            memcpy(out, char_cells[data[i]], CHAR_BYTE_CELL);
+            out += CHAR_BYTE_CELL;
+            ++i;
+            continue;
         }
 
-        // Check for repeating data
-        if (*position > offset) {
-            // If whole 16 bytes have been read, proceed
-
-            // Mark repeating data initial to true
-            data_repeat = true;
+        size_t length = utf8_sequence(data + i, count - i);
+        if (length == 0) {
+            // Stray byte
+            *out++ = ' ';
+            out = put_number(out, data[i], OCTAL_BYTE_DIGITS, 8);
+            ++i;
+            continue;
+        }
 
-            // Iterate through both buffers to find repeating data
-            for (int i = 0; i < successfully_read; ++i) {
-                // If single element is different, next iteration won't matter
-                data_repeat = data_repeat && (buffer_current[i] == buffer_previous[i]);
-            }
+        // Character in the first cell
+        memcpy(out, CHAR_UTF8_INDENT, sizeof(CHAR_UTF8_INDENT) - 1);
+        out += sizeof(CHAR_UTF8_INDENT) - 1;
+        memcpy(out, data + i, length);
+        out += length;
 
-            if (!data_repeat)           // If data isn't repeating, line isn't repeating eighter
-                line_repeat = false;
+        for (size_t j = 1; j < length; ++j) {
+            // Marks in the cells of continuation bytes
+            memcpy(out, CHAR_UTF8_INDENT UTF8_CONTINUATION_MARK, sizeof(CHAR_UTF8_INDENT UTF8_CONTINUATION_MARK) - 1);
+            out += sizeof(CHAR_UTF8_INDENT UTF8_CONTINUATION_MARK) - 1;
         }
 
-        // If verbose isn't set and buffers are repeating, then print out single asterisk and skip iteration
-        if (!verbose && data_repeat) {
-            // Check for repeating line
-            if (!line_repeat) {
-                fprintf(stdout, "*\n");     // Print out asterisk
-                line_repeat = true;         // Set repeating line
-            }
+        i += length;
+    }
 
-            *position = ftell(file);        // Get new position
-            continue;                       // Skip iteration
-        }
-        // Data are different or verbose is enabled - proceed
+    // Fill remaining space with white spaces
+    memset(out, ' ', (width - count) * CHAR_BYTE_CELL);
+    return out + (width - count) * CHAR_BYTE_CELL;
+}
 
-        // Print current position
-        print_offset(file, ndigits, *position);
+// Render hexadecimal columns of canonical display - static function
+static __forceinline char* render_canonical_hex(
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
+) {
+    // Separate position and hex values
+    *out++ = CAN_HEX_SEPARATOR;
 
-        // Iterate through current buffer
-        for (int i = 0; i < successfully_read; ++i) {
-            // Iterate through read elements
-            fprintf(stdout, OCTAL_BYTE_FORMAT, buffer_current[i]);
-        }
+    for (size_t i = 0; i < width; ++i) {
+        // Check where the iteration is
+        if (i == width / 2)
+            // Separate second half
+            *out++ = CAN_HEX_SEPARATOR;
 
-        // Get new position from number of successfuly read bytes
-        *position += successfully_read * BYTE_SIZE;
+        *out++ = CAN_HEX_SEPARATOR;
 
-        // Fill remaining space with white spaces
-        for (int i = successfully_read; i < BYTE_ARRAY_NUM; ++i) {
-            fprintf(stdout, "    ");
+        if (i < count) {
+            // Print hexadecimal format
+            out[0] = hex_digits[data[i] >> 4];
+            out[1] = hex_digits[data[i] & 0xf];
         }
+        else
+            // Print spaces
+            out[0] = out[1] = ' ';
 
-        // Issue end of line
-        putchar('\n');
-    } while (*position < endoffset);
+        out += CAN_HEX_DIGITS;
+    }
 
-    // Reached end of file
-    print_offset(file, ndigits, *position);         // Print ending position
-    putchar('\n');                                  // Last line feed
+    // Separate hex values from ASCII data
+    memcpy(out, CAN_ASCII_SEPARATOR, sizeof(CAN_ASCII_SEPARATOR) - 1);
+    out += sizeof(CAN_ASCII_SEPARATOR) - 1;
 
-    return 0;
+    return out;
 }
 
-// Dump byte characters
-int dump_byte_char(
-    FILE* file,
-    bool verbose,
-    size_t offset,
-    size_t* position,
-    size_t endoffset
+// Render canonical columns - static function
+static __forceinline char* render_canonical(
+    const dump_format_t* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
 ) {
     // Format:
-    // "%07x" or greater for offset at the beginning (aligned to 0x10 for value less than end of file)
-    // "  %c" for each valid 16 bytes of input data (aligned as 8bit values) for printable characters
-    // or "\\?" where ? is escape sequence for control characters
-    // or "%3o" for other valid values (separated by spaces)
-    // or empty spaces for invalid bytes at the beginning
-    // If end of file reached, only offset is printed
-
-    // Calculate number of digits based on ending offset
-    size_t ndigits = get_offset_digits(endoffset);
-
-    // Initialize buffers (16 bytes, arranged as 8 2-byte values)
-    ubyte_t buffer_current[BYTE_ARRAY_NUM];
-    ubyte_t buffer_previous[BYTE_ARRAY_NUM];
+    // 2 spaces
+    // "%02x" for each first half of input data bytes (separated by 1 space)
+    // 2 spaces
+    // "%02x" for each second half of input data bytes (separated by 1 space)
+    // or empty spaces for invalid bytes at the end
+    // 2 spaces
+    // Valid input data displayed as ASCII text or '.' for non-ASCII printable values,
+    // surrounded with '|' at the beginning and the end
 
-    bool data_repeat = false;           // Repeating data
-    bool line_repeat = false;           // Repeating line
+    out = render_canonical_hex(out, data, count, width);
 
-    size_t successfully_read = 0;
+    // Print ASCII border
+    *out++ = CAN_ASCII_FORMAT_BORDER;
 
-    // Print out data in 1-byte char format 
-    //  (if valid character, or escape sequence for standard codes or octal number for other values)
-    do {
-        // Run at least once
-
-        // Check for previous iteration round - full line counts
-        if (successfully_read == BYTE_ARRAY_NUM) {
-            // Previously read full 16 bytes -> copy all current buffer into previous one
-            for (int i = 0; i < BYTE_ARRAY_NUM; ++i) {
-                buffer_previous[i] = buffer_current[i];
-            }
-        }
+    // Iterate through data and print their printable ASCII or '.'
+    for (size_t i = 0; i < count; ++i) {
+        ubyte_t value = data[i];
+        *out++ = (value < ASCII_LOWEST || value > ASCII_HIGHEST) ? CAN_ASCII_FORMAT_NONASCII : value;
+    }
 
-        // Read into current buffer -> count number of successful 
-        successfully_read = fread(buffer_current, BYTE_SIZE, BYTE_ARRAY_NUM, file);
+    // Print ASCII border
+    *out++ = CAN_ASCII_FORMAT_BORDER;
 
-        if ((successfully_read < BYTE_ARRAY_NUM) && (ftell(file) < endoffset)) {
-            // An error occured while reading file
+    return out;
+}
 
-            putchar('\n');      // Divide space between data and error message
-            print_file_error("An error occured while file contents output");
+// Render canonical columns with UTF-8 text - static function
+static __forceinline char* render_canonical_utf8(
+    const dump_format_t* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
+) {
+    // Format:
+    // Same as canonical columns, valid UTF-8 sequences are displayed as the decoded
+    // character followed by a middle dot for each continuation byte
 
-            return errno;       // End with specific return code for given error
-        }
+    if (is_ascii(data, count))
+        // Plain ASCII line
+        return render_canonical(format, out, data, count, width);
 
-        // Check for repeating data
-        if (*position > offset) {
-            // If whole 16 bytes have been read, proceed
+    out = render_canonical_hex(out, data, count, width);
 
-            // Mark repeating data initial to true
-            data_repeat = true;
+    // Print ASCII border
+    *out++ = CAN_ASCII_FORMAT_BORDER;
 
-            // Iterate through both buffers to find repeating data
-            for (int i = 0; i < successfully_read; ++i) {
-                // If single element is different, next iteration won't matter
-                data_repeat = data_repeat && (buffer_current[i] == buffer_previous[i]);
-            }
+    for (size_t i = 0; i < count;) {
+        size_t length = (data[i] < ASCII_DOS_CP_BEGIN) ? 0 : utf8_sequence(data + i, count - i);
 
-            if (!data_repeat)           // If data isn't repeating, line isn't repeating eighter
-                line_repeat = false;
+        if (length == 0) {
+            // Printable ASCII or '.'
+            ubyte_t value = data[i++];
+            *out++ = (value < ASCII_LOWEST || value > ASCII_HIGHEST) ? CAN_ASCII_FORMAT_NONASCII : value;
+            continue;
         }
 
-        // If verbose isn't set and buffers are repeating, then print out single asterisk and skip iteration
-        if (!verbose && data_repeat) {
-            // Check for repeating line
-            if (!line_repeat) {
-                fprintf(stdout, "*\n");     // Print out asterisk
-                line_repeat = true;         // Set repeating line
-            }
+        // Character followed by marks of continuation bytes
+        memcpy(out, data + i, length);
+        out += length;
 
-            *position = ftell(file);        // Get new position
-            continue;                       // Skip iteration
+        for (size_t j = 1; j < length; ++j) {
+            memcpy(out, UTF8_CONTINUATION_MARK, sizeof(UTF8_CONTINUATION_MARK) - 1);
+            out += sizeof(UTF8_CONTINUATION_MARK) - 1;
         }
-        // Data are different or verbose is enabled - proceed
-
-        // Print current position
-        print_offset(file, ndigits, *position);
 
-        // Iterate through current buffer
-        for (int i = 0; i < successfully_read; ++i) {
-            // Iterate through read elements
-            ubyte_t value = buffer_current[i];      // Copy value for determining output
+        i += length;
+    }
 
-            if (value >= ASCII_LOWEST && value <= ASCII_HIGHEST || value >= ASCII_DOS_CP_BEGIN) {
-                // Byte is printable ASCII character or equals a value in DOS codepage
-                fprintf(stdout, CHAR_BYTE_FORMAT_PRINTABLE, value);
-                continue;           // Continue in iteration
-            }
+    // Print ASCII border
+    *out++ = CAN_ASCII_FORMAT_BORDER;
 
-            switch (value) {
-                // Is not printable nor in DOS codepage
-            case CHAR_BYTE_VALUE_NULL:
-                // Null byte
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_NULL);
-                break;
-            case CHAR_BYTE_VALUE_BELL:
-                // Beep
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_BELL);
-                break;
-            case CHAR_BYTE_VALUE_BS:
-                // Backspace
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_BS);
-                break;
-            case CHAR_BYTE_VALUE_TAB:
-                // Tabulator
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_TAB);
-                break;
-            case CHAR_BYTE_VALUE_LF:
-                // Line feed
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_LF);
-                break;
-            case CHAR_BYTE_VALUE_VT:
-                // Vertical tab
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_VT);
-                break;
-            case CHAR_BYTE_VALUE_FF:
-                // Form feed
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_FF);
-                break;
-            case CHAR_BYTE_VALUE_CR:
-                // Carriage return
-                fprintf(stdout, CHAR_BYTE_FORMAT_ESCAPE_CR);
-                break;
-            default:
-                // Another value that doesn't fall in standard escape sequence
-                fprintf(stdout, OCTAL_BYTE_FORMAT, value);
-            }
-        }
+    return out;
+}
 
-        // Get new position from number of successfuly read bytes
-        *position += successfully_read * BYTE_SIZE;
+// Detect vector byte swapping instructions - static function
+static bool swap_detect_vector(void) {
+#if defined(SWAP_VECTOR_X86)
+    // SSSE3 is reported in bit 9 of ECX of the first CPUID leaf
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#elif defined(SWAP_VECTOR_ARM)
+    // NEON is mandatory for 64-bit ARM Windows
+    return true;
+#else
+    return false;
+#endif
+}
 
-        // Fill remaining space with white space
-        for (int i = successfully_read; i < BYTE_ARRAY_NUM; ++i) {
-            fprintf(stdout, "    ");
+// Reverse byte order of each unit - static function
+static void swap_units(ubyte_t* data, size_t count, size_t unit) {
+    // Count is always a multiple of TYPE_SWAP_BLOCK (buffer is padded)
+    if (unit == BYTE_SIZE)
+        return;     // Nothing to swap
+
+#if defined(SWAP_VECTOR_X86)
+    if (swap_vector_support) {
+        // Shuffle masks reversing 2, 4 and 8 byte groups
+        __m128i mask;
+        if (unit == sizeof(uword_t))
+            mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        else if (unit == sizeof(udword_t))
+            mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        else
+            mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+        for (size_t i = 0; i < count; i += TYPE_SWAP_BLOCK) {
+            // Whole vector of units at once
+            __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+            _mm_storeu_si128((__m128i*)(data + i), _mm_shuffle_epi8(block, mask));
         }
-
-        // Issue end of line
-        putchar('\n');
-    } while (*position < endoffset);
-
-    // Reached end of file
-    print_offset(file, ndigits, *position);         // Print ending position
-    putchar('\n');                                  // Last line feed
-
-    return 0;
+        return;
+    }
+#elif defined(SWAP_VECTOR_ARM)
+    if (swap_vector_support) {
+        for (size_t i = 0; i < count; i += TYPE_SWAP_BLOCK) {
+            // Whole vector of units at once
+            uint8x16_t block = vld1q_u8(data + i);
+            if (unit == sizeof(uword_t))
+                block = vrev16q_u8(block);
+            else if (unit == sizeof(udword_t))
+                block = vrev32q_u8(block);
+            else
+                block = vrev64q_u8(block);
+            vst1q_u8(data + i, block);
+        }
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < count; i += unit) {
+        // One unit at a time
+        if (unit == sizeof(uword_t)) {
+            uword_t value;
+            memcpy(&value, data + i, sizeof(value));
+            value = _byteswap_ushort(value);
+            memcpy(data + i, &value, sizeof(value));
+        }
+        else if (unit == sizeof(udword_t)) {
+            udword_t value;
+            memcpy(&value, data + i, sizeof(value));
+            value = _byteswap_ulong(value);
+            memcpy(data + i, &value, sizeof(value));
+        }
+        else {
+            uqword_t value;
+            memcpy(&value, data + i, sizeof(value));
+            value = _byteswap_uint64(value);
+            memcpy(data + i, &value, sizeof(value));
+        }
+    }
 }
 
-// Dump hex-ascii canonical
-int dump_canonical(
-    FILE* file,
-    bool verbose,
-    size_t offset,
-    size_t* position,
-    size_t endoffset
-) {
-    // Format:
-    // "%07x" or greater for offset at the beginning (aligned to 0x10 for value less than end of file)
-    // 2 spaces
-    // "%02x" for each first 8 bytes of input data (aligned as 8bit values) (separated by 1 space)
-    // 2 spaces
-    // "%02x" for each valid 16 bytes of input data (aligned as 8bit values) (separated by 1 space)
-    // or empty spaces for invalid bytes at the beginning
-    // 2 spaces
-    // 16 bytes of valid input data displayed as ASCII text or '.' for non-ASCII printable values,
-    // surrounded with '|' at the beginning and the end
-    // If end of file reached, only offset is printed
-
-    // Calculate number of digits based on ending offset
-    size_t ndigits = get_offset_digits(endoffset);
-
-    // Initialize buffers (16 bytes, arranged as 8 2-byte values)
-    ubyte_t buffer_current[BYTE_ARRAY_NUM];
-    ubyte_t buffer_previous[BYTE_ARRAY_NUM];
-
-    bool data_repeat = false;           // Repeating data
-    bool line_repeat = false;           // Repeating line
+// Render signed decimal number aligned to the right - static function
+static __forceinline char* put_signed(char* out, uqword_t value, size_t digits, size_t unit) {
+    // Extend sign of the unit to the whole value
+    int bits = (int)(unit * 8);
+    long long number = (bits < 64) ? (long long)(value << (64 - bits)) >> (64 - bits) : (long long)value;
+    uqword_t magnitude = (number < 0) ? 0 - (uqword_t)number : (uqword_t)number;
 
-    size_t successfully_read = 0;
-
-    // Print out data in canonical 1-byte hex + ASCII notation
+    // Digits are filled from the right, then sign and spaces
+    size_t i = digits;
     do {
-        // Run at least once
-
-        // Check for previous iteration round - full line counts
-        if (successfully_read == BYTE_ARRAY_NUM) {
-            // Previously read full 16 bytes -> copy all current buffer into previous one
-            for (int i = 0; i < BYTE_ARRAY_NUM; ++i) {
-                buffer_previous[i] = buffer_current[i];
-            }
-        }
+        out[--i] = hex_digits[magnitude % 10];
+        magnitude /= 10;
+    } while (magnitude > 0 && i > 0);
 
-        // Read into current buffer -> count number of successful 
-        successfully_read = fread(buffer_current, BYTE_SIZE, BYTE_ARRAY_NUM, file);
+    if (number < 0 && i > 0)
+        out[--i] = '-';
 
-        if ((successfully_read < BYTE_ARRAY_NUM) && (ftell(file) < endoffset)) {
-            // An error occured while reading file
-
-            putchar('\n');      // Divide space between data and error message
-            print_file_error("An error occured while file contents output");
+    memset(out, ' ', i);
+    return out + digits;
+}
 
-            return errno;       // End with specific return code for given error
+// Render typed columns - static function
+static char* render_typed(
+    const dump_format_t* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
+) {
+    // Format:
+    // Leading space and number for each valid unit of input data, hexadecimal and unsigned
+    // decimal numbers are zero-filled, signed decimal and floating point numbers are aligned
+    // to the right
+    // or empty spaces for invalid units at the end
+
+    // Line is copied and padded up to a whole vector, so an incomplete unit at the end
+    // gets zero bytes in place of the missing ones (in the file order, before swapping)
+    ubyte_t line[DUMP_MAX_LINE_WIDTH + TYPE_SWAP_BLOCK];
+    size_t padded = (count + TYPE_SWAP_BLOCK - 1) / TYPE_SWAP_BLOCK * TYPE_SWAP_BLOCK;
+    memcpy(line, data, count);
+    memset(line + count, 0, padded - count);
+
+    if (format->big_endian)
+        // Whole line is swapped before any unit is displayed
+        swap_units(line, padded, format->unit);
+
+    for (size_t i = 0; i < width; i += format->unit) {
+        // Leading spaces of a column
+        memset(out, ' ', format->spaces);
+        out += format->spaces;
+
+        if (i >= count) {
+            // Fill remaining space with white spaces
+            memset(out, ' ', format->digits);
+            out += format->digits;
+            continue;
         }
 
-        // Check for repeating data
-        if (*position > offset) {
-            // If whole 16 bytes have been read, proceed
-
-            // Mark repeating data initial to true
-            data_repeat = true;
+        // Print unit value (system endianness is little endian)
+        uqword_t value = load_unit(line + i, format->unit, format->unit);
 
-            // Iterate through both buffers to find repeating data
-            for (int i = 0; i < successfully_read; ++i) {
-                // If single element is different, next iteration won't matter
-                data_repeat = data_repeat && (buffer_current[i] == buffer_previous[i]);
+        if (format->is_float) {
+            // Shortest digits reading back as the same number
+            if (format->unit == sizeof(float)) {
+                float number;
+                udword_t single = (udword_t)value;
+                memcpy(&number, &single, sizeof(number));
+                out = format_float(out, number, format->digits);
             }
-
-            if (!data_repeat)           // If data isn't repeating, line isn't repeating eighter
-                line_repeat = false;
-        }
-
-        // If verbose isn't set and buffers are repeating, then print out single asterisk and skip iteration
-        if (!verbose && data_repeat) {
-            // Check for repeating line
-            if (!line_repeat) {
-                fprintf(stdout, "*\n");     // Print out asterisk
-                line_repeat = true;         // Set repeating line
+            else {
+                double number;
+                memcpy(&number, &value, sizeof(number));
+                out = format_double(out, number, format->digits);
             }
-
-            *position = ftell(file);        // Get new position
-            continue;                       // Skip iteration
         }
-        // Data are different or verbose is enabled - proceed
-
-        // Print current position
-        print_offset(file, ndigits, *position);
+        else if (format->is_signed)
+            out = put_signed(out, value, format->digits, format->unit);
+        else if (format->base == 16)
+            out = put_number(out, value, format->digits, 16);
+        else
+            out = put_number(out, value, format->digits, 10);
+    }
 
-        // Separate position and hex values
-        putchar(CAN_HEX_SEPARATOR);
+    return out;
+}
 
-        // Iterate through current buffer
-        for (int i = 0; i < successfully_read; ++i) {
-            // Check where the iteration is
-            if (i == WORD_ARRAY_NUM)
-                // Separate second half
-                putchar(CAN_HEX_SEPARATOR);
-            
-            // Print hexadecimal format
-            fprintf(stdout, CAN_HEX_FORMAT, buffer_current[i]);
-        }
+// Define full line renderers of a format for each specialized width
+// (both format and width are constants there, so the column loops get unrolled
+// and the number conversion loses its base switch)
+#define DEFINE_FULL_RENDERER(name, render, format, width) \
+    static char* name##_##width(const dump_format_t* unused, char* out, const ubyte_t* data, size_t count, size_t unused_width) { \
+        return render(&format, out, data, width, width); \
+    }
+#define DEFINE_FULL_RENDERERS(name, render, format) \
+    DEFINE_FULL_RENDERER(name, render, format, 8) \
+    DEFINE_FULL_RENDERER(name, render, format, 16) \
+    DEFINE_FULL_RENDERER(name, render, format, 32) \
+    DEFINE_FULL_RENDERER(name, render, format, 64) \
+    static const dump_render_t name##_full[DUMP_SPECIALIZED_WIDTHS] = { \
+        name##_8, name##_16, name##_32, name##_64 \
+    };
+
+DEFINE_FULL_RENDERERS(plain_hex, render_units, format_plain_hex)
+DEFINE_FULL_RENDERERS(byte_octal, render_units, format_byte_octal)
+DEFINE_FULL_RENDERERS(byte_binary, render_binary, format_byte_binary)
+DEFINE_FULL_RENDERERS(byte_char, render_chars, format_byte_char)
+DEFINE_FULL_RENDERERS(canonical, render_canonical, format_canonical)
+DEFINE_FULL_RENDERERS(byte_char_utf8, render_chars_utf8, format_byte_char_utf8)
+DEFINE_FULL_RENDERERS(canonical_utf8, render_canonical_utf8, format_canonical_utf8)
+DEFINE_FULL_RENDERERS(word_decimal, render_units, format_word_decimal)
+DEFINE_FULL_RENDERERS(word_octal, render_units, format_word_octal)
+DEFINE_FULL_RENDERERS(word_hex, render_units, format_word_hex)
+
+// Generic renderers for lines of any width - static functions
+static char* render_units_any(const dump_format_t* format, char* out, const ubyte_t* data, size_t count, size_t width) {
+    return render_units(format, out, data, count, width);
+}
+static char* render_binary_any(const dump_format_t* format, char* out, const ubyte_t* data, size_t count, size_t width) {
+    return render_binary(format, out, data, count, width);
+}
+static char* render_chars_any(const dump_format_t* format, char* out, const ubyte_t* data, size_t count, size_t width) {
+    return render_chars(format, out, data, count, width);
+}
+static char* render_canonical_any(const dump_format_t* format, char* out, const ubyte_t* data, size_t count, size_t width) {
+    return render_canonical(format, out, data, count, width);
+}
+static char* render_chars_utf8_any(const dump_format_t* format, char* out, const ubyte_t* data, size_t count, size_t width) {
+    return render_chars_utf8(format, out, data, count, width);
+}
+static char* render_canonical_utf8_any(const dump_format_t* format, char* out, const ubyte_t* data, size_t count, size_t width) {
+    return render_canonical_utf8(format, out, data, count, width);
+}
 
-        // Fill remaining space with white space
-        for (int i = successfully_read; i < BYTE_ARRAY_NUM; ++i) {
-            // Check where the iteration is
-            if (i == WORD_ARRAY_NUM)
-                // Separate second half
-                putchar(CAN_HEX_SEPARATOR);
+// Line formats
+const dump_format_t format_plain_hex = {
+    // Two-byte hexadecimal (system endianness), eight columns
+    WORD_SIZE, HEX_PLAIN_SPACES, HEX_PLAIN_DIGITS, 16, render_units_any, plain_hex_full
+};
+const dump_format_t format_byte_octal = {
+    // One-byte octal, sixteen columns
+    BYTE_SIZE, OCTAL_BYTE_SPACES, OCTAL_BYTE_DIGITS, 8, render_units_any, byte_octal_full
+};
+const dump_format_t format_byte_binary = {
+    // One-byte binary, sixteen columns
+    BYTE_SIZE, BINARY_BYTE_SPACES, BINARY_BYTE_DIGITS, 2, render_binary_any, byte_binary_full
+};
+const dump_format_t format_byte_char = {
+    // One-byte character, sixteen columns
+    BYTE_SIZE, 0, 0, 0, render_chars_any, byte_char_full
+};
+const dump_format_t format_canonical = {
+    // One-byte hexadecimal followed by ASCII
+    BYTE_SIZE, 0, 0, 16, render_canonical_any, canonical_full
+};
+const dump_format_t format_byte_char_utf8 = {
+    // One-byte character, UTF-8 sequences decoded, sixteen columns
+    BYTE_SIZE, 0, 0, 0, render_chars_utf8_any, byte_char_utf8_full
+};
+const dump_format_t format_canonical_utf8 = {
+    // One-byte hexadecimal followed by UTF-8 text
+    BYTE_SIZE, 0, 0, 16, render_canonical_utf8_any, canonical_utf8_full
+};
+const dump_format_t format_word_decimal = {
+    // Two-byte unsigned decimal (system endianness), eight columns
+    WORD_SIZE, DECIMAL_WORD_SPACES, DECIMAL_WORD_DIGITS, 10, render_units_any, word_decimal_full
+};
+const dump_format_t format_word_octal = {
+    // Two-byte octal (system endianness), eight columns
+    WORD_SIZE, OCTAL_WORD_SPACES, OCTAL_WORD_DIGITS, 8, render_units_any, word_octal_full
+};
+const dump_format_t format_word_hex = {
+    // Two-byte hexadecimal (system endianness), eight columns
+    WORD_SIZE, HEX_WORD_SPACES, HEX_WORD_DIGITS, 16, render_units_any, word_hex_full
+};
+
+// Set up typed display format
+bool dump_parse_type(const char* string, dump_format_t* format) {
+    // Specification is a type letter, optionally followed by unit size and endianness
+    char type = *string++;
+    size_t unit = (type == TYPE_FLOAT) ? TYPE_DEFAULT_FLOAT_SIZE : TYPE_DEFAULT_SIZE;
+
+    if (type != TYPE_HEX && type != TYPE_UNSIGNED && type != TYPE_SIGNED && type != TYPE_FLOAT)
+        return false;   // Unknown type
+
+    if (*string >= '0' && *string <= '9') {
+        // Unit size stated
+        unit = *string++ - '0';
+        if (unit != 1 && unit != 2 && unit != 4 && unit != 8)
+            return false;
+    }
 
-            // Print spaces
-            fprintf(stdout, "   ");
-        }
+    if (type == TYPE_FLOAT && unit != sizeof(float) && unit != sizeof(double))
+        return false;   // Only single and double precision
+
+    format->big_endian = false;
+    if (strcmp(string, TYPE_ENDIAN_BIG) == 0)
+        format->big_endian = true;
+    else if (*string != 0 && strcmp(string, TYPE_ENDIAN_LITTLE) != 0)
+        return false;   // Unknown endianness
+
+    // Column digits by unit size (1, 2, 4 or 8 bytes)
+    int size_index = (unit == 1) ? 0 : (unit == 2) ? 1 : (unit == 4) ? 2 : 3;
+
+    format->unit = unit;
+    format->spaces = TYPE_SPACES;
+    format->base = (type == TYPE_HEX) ? 16 : 10;
+    format->is_signed = (type == TYPE_SIGNED);
+    format->is_float = (type == TYPE_FLOAT);
+    format->digits = (type == TYPE_HEX) ? type_hex_digits[size_index] :
+                     (type == TYPE_SIGNED) ? type_signed_digits[size_index] :
+                     (type == TYPE_UNSIGNED) ? type_unsigned_digits[size_index] :
+                     (unit == sizeof(float)) ? FLOAT_SINGLE_COLUMN : FLOAT_DOUBLE_COLUMN;
+    format->render = render_typed;
+    format->render_full = NULL;
+
+    if (swap_vector_support < 0)
+        swap_vector_support = swap_detect_vector();
+
+    return true;
+}
 
-        // Separate hex values from ASCII data
-        fprintf(stdout, CAN_ASCII_SEPARATOR);
+// Pick full line renderer for given width
+dump_render_t dump_full_renderer(const dump_format_t* format, size_t width) {
+    size_t specialized = DUMP_SPECIALIZED_MIN;
 
-        // Print ASCII border
-        putchar(CAN_ASCII_FORMAT_BORDER);
+    for (int i = 0; i < DUMP_SPECIALIZED_WIDTHS; ++i, specialized *= 2) {
+        // Look for a renderer of exactly this width
+        if (width == specialized && format->render_full)
+            return format->render_full[i];
+    }
 
-        // Iterate through data and print their printable ASCII or '.'
-        for (int i = 0; i < successfully_read; ++i) {
-            // Copy value for comparison
-            ubyte_t value = buffer_current[i];
+    // Uncommon width -> generic renderer
+    return format->render;
+}
 
-            // Check byte data for printable ASCII values
-            if (value < ASCII_LOWEST || value > ASCII_HIGHEST)
-                // Not printable -> print '.' instead
-                putchar(CAN_ASCII_FORMAT_NONASCII);
-            else
-                // Printable ASCII value, print out direct value
-                putchar(value);
-        }
+// Print offset
+void print_offset(FILE* file, size_t ndigits, size_t position) {
+    char offset[MAX_OFFSET_DIGITS];     // Offset is never longer than 16 digits
 
-        // Print ASCII border
-        putchar(CAN_ASCII_FORMAT_BORDER);
+    // Return offset hexadecimal value
+    put_number(offset, position, ndigits, 16);
+    fwrite(offset, 1, ndigits, file);
+}
 
-        // Get new position from number of successfuly read bytes
-        *position += successfully_read * BYTE_SIZE;
+// Calculate number of digits
+size_t get_offset_digits(uqword_t number) {
+    // Get number of digits for offset display
+    size_t ndigits = MIN_OFFSET_DIGITS;     // Init number of digits - bare minimum is 7
+    register uqword_t num_copy = number;      // Init operations on given offset value
 
-        // Line feed at the end
-        putchar('\n');
-    } while (*position < endoffset);
+    // For number greater or equal to 0x10000000 add appropriate number of digits
+    while(num_copy >= OVERFLOW_VALUE) {
+        num_copy /= 16;     // Hexadecimal division
+        ++ndigits;          // Count the digits
+    }
 
-    // Reached end of file
-    print_offset(file, ndigits, *position);         // Print ending position
-    putchar('\n');                                  // Last line feed
+    // Return number of digits
+    return ndigits;
+}
 
-    return 0;
+// Prepare line formats for rendering
+void dump_prepare(void) {
+    if (!char_cells_ready)
+        init_char_cells();
 }
 
-// Dump word decimal
-int dump_word_decimal(
-    FILE* file,
-    bool verbose,
-    size_t offset,
-    size_t* position,
-    size_t endoffset
+// Render single line
+char* dump_render_line(
+    const dump_format_t* format,
+    char* out,
+    size_t ndigits,
+    uqword_t position,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
 ) {
-    // Format:
-    // "%07x" or greater for offset at the beginning (aligned to 0x10 for value less than end of file)
-    // 3 spaces
-    // "%05d" for each valid 16 bytes of input data (aligned as 16bit values) (separated with 3 spaces)
-    // or empty spaces for invalid bytes at the beginning
-    // If end of file reached, only offset is printed
-
-    // Calculate number of digits based on ending offset
-    size_t ndigits = get_offset_digits(endoffset);
+    // Print current position
+    out = put_number(out, position, ndigits, 16);
 
-    // Initialize buffers (16 bytes, arranged as 8 2-byte values)
-    uword_t buffer_current[WORD_ARRAY_NUM];
-    uword_t buffer_previous[WORD_ARRAY_NUM];
-
-    ubyte_t remainder = 0;              // Save up for last remaining byte
-
-    bool data_repeat = false;           // Repeating data
-    bool line_repeat = false;           // Repeating line
-
-    size_t successfully_read = 0;
+    // Print line data (full lines use renderer specialized for the width)
+    if (count == width)
+        return dump_full_renderer(format, width)(format, out, data, count, width);
+    return format->render(format, out, data, count, width);
+}
 
-    // Print out data in 2-byte aligned decimal format
-    do {
-        // Run at least once
+// Make room for one more line in output buffer - static function
+static char* dump_reserve(dump_state_t* state) {
+    if (DUMP_OUTPUT_SIZE - state->buffered < DUMP_MAX_LINE_CHARS)
+        // Not enough space left -> write buffer out
+        dump_flush(state);
 
-        // Check for previous iteration round - full line counts
-        if (successfully_read == WORD_ARRAY_NUM) {
-            // Previously read full 16 bytes -> copy all current buffer into previous one
-            for (int i = 0; i < WORD_ARRAY_NUM; ++i) {
-                buffer_previous[i] = buffer_current[i];
-            }
-        }
+    return state->buffer + state->buffered;
+}
 
-        // Read into current buffer -> count number of successful 
-        successfully_read = fread(buffer_current, WORD_SIZE, WORD_ARRAY_NUM, file);
+// Print pending back-reference - static function
+static void dump_reference(dump_state_t* state) {
+    // Format:
+    // Offset of first replaced line
+    // " = same as " marker
+    // Offset of its earlier copy
+    // Number of lines (only if there are more of them)
+
+    if (state->reference_lines == 0)
+        return;     // Nothing pending
+
+    char* out = dump_reserve(state);
+    out = put_number(out, state->reference_begin, state->ndigits, 16);
+    memcpy(out, DUMP_DEDUP_MARKER, sizeof(DUMP_DEDUP_MARKER) - 1);
+    out += sizeof(DUMP_DEDUP_MARKER) - 1;
+    out = put_number(out, state->reference_source, state->ndigits, 16);
+
+    if (state->reference_lines > 1)
+        out += sprintf(out, " (%llu lines)", (unsigned long long)state->reference_lines);
+
+    *out++ = '\n';
+    state->buffered = out - state->buffer;
+    state->reference_lines = 0;
+}
 
-        if ((successfully_read < WORD_ARRAY_NUM) && (ftell(file) < endoffset)) {
-            // An error occured while reading file
+// Replace full line seen earlier with back-reference - static function
+static bool dump_dedup(dump_state_t* state, const ubyte_t* line) {
+    // Lines are looked up by their hash only, a slot keeps the first line
+    // with its hash until a line with another hash takes the slot over
+    uqword_t hash = checksum_once(CHECKSUM_XXH64, line, state->width);
+    dump_seen_t* slot = &state->seen[hash & (DUMP_DEDUP_SLOTS - 1)];
+    ++state->dedup_total;
+
+    if (slot->position == 0 || slot->hash != hash) {
+        // New line, remember where it is
+        slot->hash = hash;
+        slot->position = state->position + 1;
+        return false;
+    }
 
-            putchar('\n');      // Divide space between data and error message
-            print_file_error("An error occured while file contents output");
+    size_t source = slot->position - 1;
+    if (state->reference_lines == 0
+        || state->reference_begin + state->reference_lines * state->width != state->position
+        || state->reference_source + state->reference_lines * state->width != source) {
+        // Lines that don't continue pending back-reference start another one
+        dump_reference(state);
+        state->reference_begin = state->position;
+        state->reference_source = source;
+        state->reference_lines = 0;
+    }
 
-            return errno;       // End with specific return code for given error
-        }
+    ++state->reference_lines;
+    ++state->dedup_lines;
+    return true;
+}
 
-        // Check for repeating data
-        if (*position > offset) {
-            // If whole 16 bytes have been read, proceed
+// Render checksum line - static function
+static void dump_checksum_line(dump_state_t* state, size_t begin, size_t end, uqword_t value) {
+    // Format:
+    // Checksum algorithm name
+    // 1 space
+    // Offsets of the checksummed range (begin-end)
+    // 1 space
+    // Hexadecimal checksum value
 
-            // Mark repeating data initial to true
-            data_repeat = true;
+    dump_reference(state);
 
-            // Iterate through both buffers to find repeating data
-            for (int i = 0; i < successfully_read; ++i) {
-                // If single element is different, next iteration won't matter
-                data_repeat = data_repeat && (buffer_current[i] == buffer_previous[i]);
-            }
+    int algorithm = state->options.checksum;
+    const char* name = checksum_name(algorithm);
+    char* out = dump_reserve(state);
 
-            if (!data_repeat)           // If data isn't repeating, line isn't repeating eighter
-                line_repeat = false;
-        }
+    memcpy(out, name, strlen(name));
+    out += strlen(name);
+    *out++ = ' ';
+    out = put_number(out, begin, state->ndigits, 16);
+    *out++ = '-';
+    out = put_number(out, end, state->ndigits, 16);
+    *out++ = ' ';
+    out = put_number(out, value, checksum_digits(algorithm), 16);
+    *out++ = '\n';
 
-        // If verbose isn't set and buffers are repeating, then print out single asterisk and skip iteration
-        if (!verbose && data_repeat) {
-            // Check for repeating line
-            if (!line_repeat) {
-                fprintf(stdout, "*\n");     // Print out asterisk
-                line_repeat = true;         // Set repeating line
-            }
+    state->buffered = out - state->buffer;
+}
 
-            *position = ftell(file);        // Get new position
-            continue;                       // Skip iteration
+// Add line to block checksums - static function
+static void dump_block_checksum(dump_state_t* state, const ubyte_t* data, size_t count) {
+    while (count > 0) {
+        // Split data at block boundaries
+        size_t take = state->options.checksum_block - state->block_count;
+        if (take > count)
+            take = count;
+
+        checksum_update(&state->block_sum, data, take);
+        state->block_count += take;
+        data += take;
+        count -= take;
+
+        if (state->block_count == state->options.checksum_block) {
+            // Block is complete -> print its checksum and start next one
+            dump_checksum_line(state, state->block_start, state->block_start + state->block_count, checksum_final(&state->block_sum));
+            checksum_init(&state->block_sum, state->options.checksum);
+            state->block_start += state->block_count;
+            state->block_count = 0;
+
+            // Repeating lines after checksum get their own asterisk
+            state->line_repeat = false;
         }
-        // Data are different or verbose is enabled - proceed
-
-        // Print current position
-        print_offset(file, ndigits, *position);
+    }
+}
 
-        // Iterate through current buffer
-        for (int i = 0; i < successfully_read; ++i) {
-            // Iterate through read elements
-            fprintf(stdout, DECIMAL_WORD_FORMAT, buffer_current[i]);
-        }
+// Dump single line - static function
+static void dump_line(dump_state_t* state, const ubyte_t* line, size_t count) {
+    if (state->options.output != OUTPUT_TEXT) {
+        // Structured record of the line (checksum of each record when requested)
+        int algorithm = state->options.checksum;
+        uqword_t sum = (algorithm != CHECKSUM_NONE) ? checksum_once(algorithm, line, count) : 0;
+        char* out = record_put(dump_reserve(state), state->options.output, state->options.encoding, state->position, line, count, algorithm, sum);
+
+        state->buffered = out - state->buffer;
+        state->position += count;
+        return;
+    }
 
-        // Get new position from number of successfuly read bytes
-        *position += successfully_read * WORD_SIZE;
+    // Only full lines can repeat
+    bool full = (count == state->width);
+    bool data_repeat = full && state->has_previous && memcmp(line, state->previous, count) == 0;
 
-        // Check for last remanining byte in incomplete 16byte data buffer
-        if ((*position == endoffset - BYTE_SIZE) && (successfully_read < 8)) {
-            fseek(file, *position, SEEK_SET);                                   // Reset to last known position
-            successfully_read += fread(&remainder, BYTE_SIZE, 1, file);         // Read single byte
-            fprintf(stdout, DECIMAL_WORD_FORMAT, remainder);                    // Print remainder out
-            *position = ftell(file);                                            // Update position to finish iteration
+    // If verbose isn't set and data are repeating, then print out single asterisk and skip the line
+    if (state->seen && full && (state->options.verbose || !data_repeat) && dump_dedup(state, line)) {
+        // Line seen earlier (back-reference printed with following lines)
+        state->line_repeat = false;
+    }
+    else if (!state->options.verbose && data_repeat) {
+        dump_reference(state);
+
+        // Check for repeating line
+        if (!state->line_repeat) {
+            char* out = dump_reserve(state);
+            memcpy(out, DUMP_SQUEEZE_MARKER, sizeof(DUMP_SQUEEZE_MARKER) - 1);      // Print out asterisk
+            state->buffered += sizeof(DUMP_SQUEEZE_MARKER) - 1;
+            state->line_repeat = true;                                                // Set repeating line
         }
-
-        // Fill remaining space with white spaces
-        for (int i = successfully_read; i < WORD_ARRAY_NUM; ++i) {
-            fprintf(stdout, "        ");
+    }
+    else {
+        // Data are different or verbose is enabled - proceed
+        dump_reference(state);
+        state->line_repeat = false;
+        char* out = dump_reserve(state);
+
+        // Print current position and line data (full lines use renderer specialized for the width)
+        out = put_number(out, state->position, state->ndigits, 16);
+        out = (full) ? state->render_full(state->format, out, line, count, state->width)
+                     : state->format->render(state->format, out, line, count, state->width);
+
+        if (state->options.checksum != CHECKSUM_NONE && state->options.checksum_block == 0) {
+            // Append line checksum
+            int algorithm = state->options.checksum;
+            memcpy(out, CHECKSUM_COLUMN_SEPARATOR, sizeof(CHECKSUM_COLUMN_SEPARATOR) - 1);
+            out += sizeof(CHECKSUM_COLUMN_SEPARATOR) - 1;
+            out = put_number(out, checksum_once(algorithm, line, count), checksum_digits(algorithm), 16);
         }
 
         // Issue end of line
-        putchar('\n');
-    } while (*position < endoffset);
+        *out++ = '\n';
+        state->buffered = out - state->buffer;
+    }
 
-    // Reached end of file
-    print_offset(file, ndigits, *position);         // Print ending position
-    putchar('\n');                                  // Last line feed
+    if (full && !data_repeat) {
+        // Keep full line for comparison with next one
+        memcpy(state->previous, line, count);
+        state->has_previous = true;
+    }
 
-    return 0;
+    // Get new position from number of dumped bytes
+    state->position += count;
+
+    if (state->options.checksum != CHECKSUM_NONE && state->options.checksum_block > 0)
+        // Checksum blocks follow the dumped lines
+        dump_block_checksum(state, line, count);
 }
 
-// Dump word octal
-int dump_word_octal(
-    FILE* file,
-    bool verbose,
+// Prepare dump of a range
+bool dump_init(
+    dump_state_t* state,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    FILE* out,
     size_t offset,
-    size_t* position,
     size_t endoffset
 ) {
-    // Format:
-    // "%07x" or greater for offset at the beginning (aligned to 0x10 for value less than end of file)
-    // 2 spaces
-    // "%06o" for each valid 16 bytes of input data (aligned as 16bit values) (separated with 2 spaces)
-    // or empty spaces for invalid bytes at the beginning
-    // If end of file reached, only offset is printed
+    // Lines seen so far are kept behind output buffer (freed with it)
+    bool dedup = options->dedup && options->output == OUTPUT_TEXT;
+    state->buffer = (dedup) ? calloc(1, DUMP_OUTPUT_SIZE + DUMP_DEDUP_SLOTS * sizeof(dump_seen_t)) : malloc(DUMP_OUTPUT_SIZE);
+    if (!state->buffer)
+        return false;       // Not enough memory for output buffer
 
-    // Calculate number of digits based on ending offset
-    size_t ndigits = get_offset_digits(endoffset);
+    dump_prepare();
 
-    // Initialize buffers (16 bytes, arranged as 8 2-byte values)
-    uword_t buffer_current[WORD_ARRAY_NUM];
-    uword_t buffer_previous[WORD_ARRAY_NUM];
+    state->format = format;
+    state->options = *options;
 
-    ubyte_t remainder = 0;              // Save up for last remaining byte
+    if (options->output != OUTPUT_TEXT) {
+        // Structured records are never squeezed and carry their own checksums
+        state->options.verbose = true;
+        state->options.checksum_block = 0;
+    }
+    state->out = out;
+    state->width = options->width;
+    state->render_full = dump_full_renderer(format, options->width);
+    state->ndigits = get_offset_digits(endoffset);      // Calculate number of digits based on ending offset
+    state->position = state->begin = state->block_start = offset;
+    state->line_repeat = state->has_previous = false;
+    state->pending_count = state->buffered = state->block_count = 0;
+    state->seen = (dedup) ? (dump_seen_t*)(state->buffer + DUMP_OUTPUT_SIZE) : NULL;
+    state->reference_lines = state->dedup_lines = state->dedup_total = 0;
+
+    if (options->checksum != CHECKSUM_NONE) {
+        // Start checksums
+        checksum_init(&state->total_sum, options->checksum);
+        checksum_init(&state->block_sum, options->checksum);
+    }
 
-    bool data_repeat = false;           // Repeating data
-    bool line_repeat = false;           // Repeating line
+    return true;
+}
 
-    size_t successfully_read = 0;
+// Dump next piece of input data
+void dump_feed(dump_state_t* state, const ubyte_t* data, size_t count) {
+    if (state->options.checksum != CHECKSUM_NONE)
+        // Whole range checksum is computed in the same pass
+        checksum_update(&state->total_sum, data, count);
 
-    // Print out data in 2-byte aligned octal format
-    do {
-        // Run at least once
+    if (state->pending_count > 0) {
+        // Complete line started by previous piece of data
+        size_t take = state->width - state->pending_count;
+        if (take > count)
+            take = count;
 
-        // Check for previous iteration round - full line counts
-        if (successfully_read == WORD_ARRAY_NUM) {
-            // Previously read full 16 bytes -> copy all current buffer into previous one
-            for (int i = 0; i < WORD_ARRAY_NUM; ++i) {
-                buffer_previous[i] = buffer_current[i];
-            }
-        }
+        memcpy(state->pending + state->pending_count, data, take);
+        state->pending_count += take;
+        data += take;
+        count -= take;
 
-        // Read into current buffer -> count number of successful 
-        successfully_read = fread(buffer_current, WORD_SIZE, WORD_ARRAY_NUM, file);
+        if (state->pending_count < state->width)
+            return;     // Still incomplete
 
-        if ((successfully_read < WORD_ARRAY_NUM) && (ftell(file) < endoffset)) {
-            // An error occured while reading file
+        dump_line(state, state->pending, state->width);
+        state->pending_count = 0;
+    }
 
-            putchar('\n');      // Divide space between data and error message
-            print_file_error("An error occured while file contents output");
+    while (count >= state->width) {
+        // Full lines straight from the data
+        dump_line(state, data, state->width);
+        data += state->width;
+        count -= state->width;
+    }
 
-            return errno;       // End with specific return code for given error
-        }
+    // Keep incomplete line for next piece of data
+    memcpy(state->pending, data, count);
+    state->pending_count = count;
+}
 
-        // Check for repeating data
-        if (*position > offset) {
-            // If whole 16 bytes have been read, proceed
+// Continue dump further in file
+void dump_skip(dump_state_t* state, size_t position) {
+    if (position == state->position)
+        return;     // Nothing skipped
 
-            // Mark repeating data initial to true
-            data_repeat = true;
+    if (state->pending_count > 0) {
+        // Incomplete line before skipped data
+        dump_line(state, state->pending, state->pending_count);
+        state->pending_count = 0;
+    }
 
-            // Iterate through both buffers to find repeating data
-            for (int i = 0; i < successfully_read; ++i) {
-                // If single element is different, next iteration won't matter
-                data_repeat = data_repeat && (buffer_current[i] == buffer_previous[i]);
-            }
+    // Back-reference ends before skipped data
+    dump_reference(state);
 
-            if (!data_repeat)           // If data isn't repeating, line isn't repeating eighter
-                line_repeat = false;
-        }
+    if (state->options.checksum != CHECKSUM_NONE && state->options.checksum_block > 0 && state->block_count > 0) {
+        // Incomplete block before skipped data
+        dump_checksum_line(state, state->block_start, state->block_start + state->block_count, checksum_final(&state->block_sum));
+        checksum_init(&state->block_sum, state->options.checksum);
+        state->block_count = 0;
+    }
 
-        // If verbose isn't set and buffers are repeating, then print out single asterisk and skip iteration
-        if (!verbose && data_repeat) {
-            // Check for repeating line
-            if (!line_repeat) {
-                fprintf(stdout, "*\n");     // Print out asterisk
-                line_repeat = true;         // Set repeating line
-            }
+    if (state->options.output == OUTPUT_TEXT) {
+        // Mark the skipped data, lines on each side of it are never squeezed together
+        char* out = dump_reserve(state);
+        memcpy(out, DUMP_SKIP_MARKER, sizeof(DUMP_SKIP_MARKER) - 1);
+        state->buffered += sizeof(DUMP_SKIP_MARKER) - 1;
+    }
 
-            *position = ftell(file);        // Get new position
-            continue;                       // Skip iteration
-        }
-        // Data are different or verbose is enabled - proceed
+    state->position = state->block_start = position;
+    state->line_repeat = state->has_previous = false;
+}
 
-        // Print current position
-        print_offset(file, ndigits, *position);
+// Write buffered output
+void dump_flush(dump_state_t* state) {
+    if (state->reference_lines > 0 && DUMP_OUTPUT_SIZE - state->buffered >= DUMP_MAX_LINE_CHARS)
+        // Pending back-reference goes out with the rest
+        dump_reference(state);
 
-        // Iterate through current buffer
-        for (int i = 0; i < successfully_read; ++i) {
-            // Iterate through read elements
-            fprintf(stdout, OCTAL_WORD_FORMAT, buffer_current[i]);
-        }
+    fwrite(state->buffer, 1, state->buffered, state->out);
+    state->buffered = 0;
+}
 
-        // Get new position from number of successfuly read bytes
-        *position += successfully_read * WORD_SIZE;
+// Finish dump
+void dump_end(dump_state_t* state) {
+    if (state->pending_count > 0) {
+        // Incomplete line at the end of range
+        dump_line(state, state->pending, state->pending_count);
+        state->pending_count = 0;
+    }
 
-        // Check for last remanining byte in incomplete 16byte data buffer
-        if ((*position == endoffset - BYTE_SIZE) && (successfully_read < 8)) {
-            fseek(file, *position, SEEK_SET);                                   // Reset to last known position
-            successfully_read += fread(&remainder, BYTE_SIZE, 1, file);         // Read single byte
-            fprintf(stdout, OCTAL_WORD_FORMAT, remainder);                      // Print remainder out
-            *position = ftell(file);                                            // Update position to finish iteration
-        }
+    if (state->options.checksum != CHECKSUM_NONE && state->options.checksum_block > 0 && state->block_count > 0)
+        // Incomplete block at the end of range
+        dump_checksum_line(state, state->block_start, state->block_start + state->block_count, checksum_final(&state->block_sum));
 
-        // Fill remaining space with white spaces
-        for (int i = successfully_read; i < WORD_ARRAY_NUM; ++i) {
-            fprintf(stdout, "        ");
-        }
+    if (state->options.output != OUTPUT_TEXT) {
+        // Records carry their own offsets, there is no ending offset line
+        dump_flush(state);
+        free(state->buffer);
+        state->buffer = NULL;
+        return;
+    }
 
-        // Issue end of line
-        putchar('\n');
-    } while (*position < endoffset);
+    // Back-reference of the last lines
+    dump_reference(state);
 
-    // Reached end of file
-    print_offset(file, ndigits, *position);         // Print ending position
-    putchar('\n');                                  // Last line feed
+    // Reached end of range
+    char* out = dump_reserve(state);
+    out = put_number(out, state->position, state->ndigits, 16);     // Print ending position
+    *out++ = '\n';                                                  // Last line feed
+    state->buffered = out - state->buffer;
 
-    return 0;
+    if (state->options.checksum != CHECKSUM_NONE)
+        // Checksum of the whole range
+        dump_checksum_line(state, state->begin, state->position, checksum_final(&state->total_sum));
+
+    if (state->seen && state->dedup_total > 0)
+        // Summary of back-references (off the dump itself)
+        fprintf(stderr, "%llu of %llu lines replaced by back-references (%.1f %%)\n", (unsigned long long)state->dedup_lines,
+            (unsigned long long)state->dedup_total, 100.0 * (double)state->dedup_lines / (double)state->dedup_total);
+
+    // Tidy up
+    dump_flush(state);
+    free(state->buffer);
+    state->buffer = NULL;
 }
 
-// Dump word hex
-int dump_word_hex(
+// Dump range of a file to given stream
+int dump_stream(
     FILE* file,
-    bool verbose,
+    FILE* out,
+    const dump_format_t* format,
+    const dump_options_t* options,
     size_t offset,
     size_t* position,
     size_t endoffset
 ) {
-    // Format:
-    // "%07x" or greater for offset at the beginning (aligned to 0x10 for value less than end of file)
-    // 4 spaces
-    // " %04x" for each valid 16 bytes of input data (aligned as 16bit values) (separated by 4 spaces)
-    // or empty spaces for invalid bytes at the beginning
-    // If end of file reached, only offset is printed
-
-    // Calculate number of digits based on ending offset
-    size_t ndigits = get_offset_digits(endoffset);
-
-    // Initialize buffers (16 bytes, arranged as 8 2-byte values)
-    uword_t buffer_current[WORD_ARRAY_NUM];
-    uword_t buffer_previous[WORD_ARRAY_NUM];
-
-    ubyte_t remainder = 0;        // Save up for last remaining byte
-
-    bool data_repeat = false;           // Repeating data
-    bool line_repeat = false;           // Repeating line
-
-    size_t successfully_read = 0;
-
-    // Print out data in two-byte aligned hexadecimal format
-    do {
-        // Run at least once
-
-        // Check for previous iteration round - full line counts
-        if (successfully_read == WORD_ARRAY_NUM) {
-            // Previously read full 16 bytes -> copy all current buffer into previous one
-            for (int i = 0; i < WORD_ARRAY_NUM; ++i) {
-                buffer_previous[i] = buffer_current[i];
-            }
-        }
-
-        // Read into current buffer -> count number of successful 
-        successfully_read = fread(buffer_current, WORD_SIZE, WORD_ARRAY_NUM, file);
-
-        if ((successfully_read < WORD_ARRAY_NUM) && (ftell(file) < endoffset)) {
-            // An error occured while reading file
-
-            putchar('\n');      // Divide space between data and error message
-            print_file_error("An error occured while file contents output");
-
-            return errno;       // End with specific return code for given error
-        }
-
-        // Check for repeating data
-        if (*position > offset) {
-            // If whole 16 bytes have been read, proceed
+    dump_state_t state;
+    ubyte_t* chunk = malloc(options->chunk_size);
 
-            // Mark repeating data initial to true
-            data_repeat = true;
+    if (!chunk || !dump_init(&state, format, options, out, offset, endoffset)) {
+        // Not enough memory for buffers
+        free(chunk);
 
-            // Iterate through both buffers to find repeating data
-            for (int i = 0; i < successfully_read; ++i) {
-                // If single element is different, next iteration won't matter
-                data_repeat = data_repeat && (buffer_current[i] == buffer_previous[i]);
-            }
-
-            if (!data_repeat)           // If data isn't repeating, line isn't repeating eighter
-                line_repeat = false;
-        }
-
-        // If verbose isn't set and buffers are repeating, then print out single asterisk and skip iteration
-        if (!verbose && data_repeat) {
-            // Check for repeating line
-            if (!line_repeat) {
-                fprintf(stdout, "*\n");     // Print out asterisk
-                line_repeat = true;         // Set repeating line
-            }
-
-            *position = ftell(file);        // Get new position
-            continue;                       // Skip iteration
-        }
-        // Data are different or verbose is enabled - proceed
+        return ENOMEM;
+    }
 
-        // Print current position
-        print_offset(file, ndigits, *position);
+    while (*position < endoffset) {
+        // Read next chunk of the range
+        size_t count = (endoffset - *position < options->chunk_size) ? endoffset - *position : options->chunk_size;
+        size_t successfully_read = fread(chunk, BYTE_SIZE, count, file);
 
-        // Iterate through current buffer
-        for (int i = 0; i < successfully_read; ++i) {
-            // Iterate through read elements
-            fprintf(stdout, HEX_WORD_FORMAT, buffer_current[i]);
-        }
+        dump_feed(&state, chunk, successfully_read);
+        *position += successfully_read;
 
-        // Get new position from number of successfuly read bytes
-        *position += successfully_read * WORD_SIZE;
+        if (successfully_read < count) {
+            // An error occured while reading file, keep what was dumped so far
+            int error = errno;
+            dump_flush(&state);
 
-        // Check for last remanining byte in incomplete 16byte data buffer
-        if ((*position == endoffset - BYTE_SIZE) && (successfully_read < 8)) {
-            fseek(file, *position, SEEK_SET);                                   // Reset to last known position
-            successfully_read += fread(&remainder, BYTE_SIZE, 1, file);         // Read single byte
-            fprintf(stdout, HEX_WORD_FORMAT, remainder);                        // Print remainder out
-            *position = ftell(file);                                            // Update position to finish iteration
+            free(state.buffer);
+            free(chunk);
+            return (error != 0) ? error : EIO;
         }
+    }
 
-        // Fill remaining space with white spaces
-        for (int i = successfully_read; i < WORD_ARRAY_NUM; ++i) {
-            fprintf(stdout, "        ");
-        }
+    dump_end(&state);
+    free(chunk);
 
-        // Issue end of line
-        putchar('\n');
-    } while (*position < endoffset);
+    return 0;
+}
 
-    // Reached end of file
-    print_offset(file, ndigits, *position);         // Print ending position
-    putchar('\n');                                  // Last line feed
+// Dump range of a file
+int dump_file(
+    FILE* file,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    int retcode = dump_stream(file, stdout, format, options, offset, position, endoffset);
+
+    if (retcode == ENOMEM)
+        // Not enough memory for buffers
+        print_error_memory("Out of memory");
+    else if (retcode != 0) {
+        // An error occured while reading file
+        putchar('\n');      // Divide space between data and error message
+        errno = retcode;
+        print_file_error("An error occured while file contents output");
+    }
 
-    return 0;
+    return retcode;     // End with specific return code for given error
 }
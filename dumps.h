@@ -9,38 +9,87 @@
  * File: dumps.h
  *
  *-------------------------------------------------
- * Made by Marek Polek (Polda18)
+ * Made by Marek Poláček (Polda18)
  **************************************************/
 
 #pragma once
 
 #include <stdio.h>                     // Measure for file descriptor
+#include <stdbool.h>                   // Measure for boolean type
+#include "checksum.h"                  // Measure for checksum state
 #ifndef __DUMPS_H__
 #define __DUMPS_H__
 
  // Define basic types
+typedef unsigned long long              uqword_t;
+typedef unsigned int                    udword_t;
 typedef unsigned short                  uword_t;
 typedef unsigned char                   ubyte_t;
 
 // Define constants
 #define MIN_OFFSET_DIGITS               7
+#define MAX_OFFSET_DIGITS               16
 #define OVERFLOW_VALUE                  0x10000000
 #define BYTE_SIZE                       sizeof(ubyte_t)
 #define WORD_SIZE                       sizeof(uword_t)
 #define BYTE_ARRAY_NUM                  16 / BYTE_SIZE
 #define WORD_ARRAY_NUM                  16 / WORD_SIZE
 
-// Number format constants
-#define HEX_PLAIN_FORMAT                " %04x"
-#define OCTAL_BYTE_FORMAT               " %03o"
-#define OCTAL_WORD_FORMAT               "  %06o"
-#define DECIMAL_WORD_FORMAT             "   %05u"
-#define HEX_WORD_FORMAT                 "    %04x"
+// Buffer constants
+#define DUMP_CHUNK_SIZE                 65536       // Bytes read from file at once
+#define DUMP_OUTPUT_SIZE                65536       // Characters written to output at once
+#define DUMP_DEFAULT_WIDTH              BYTE_ARRAY_NUM  // Bytes per line unless stated otherwise
+#define DUMP_MAX_LINE_WIDTH             256         // Largest supported line in bytes
+#define DUMP_MAX_BYTE_CHARS             9           // Most characters displayed per byte (binary)
+#define DUMP_MAX_LINE_CHARS             (MAX_OFFSET_DIGITS + DUMP_MAX_LINE_WIDTH * DUMP_MAX_BYTE_CHARS + 64)
+
+// Line widths with specialized renderers (8, 16, 32 and 64 bytes)
+#define DUMP_SPECIALIZED_MIN            8           // Narrowest specialized width
+#define DUMP_SPECIALIZED_WIDTHS         4           // Number of specialized widths (each double the previous)
+
+// Squeezed lines marker
+#define DUMP_SQUEEZE_MARKER             "*\n"
+
+// Marker between skipped parts of file (sampling)
+#define DUMP_SKIP_MARKER                "--\n"
+
+// Back-reference in place of lines seen earlier (-g)
+#define DUMP_DEDUP_MARKER               "  = same as "
+#define DUMP_DEDUP_SLOTS                262144      // Lines remembered by their hash (power of two, colliding lines replace older ones)
+
+// Checksum constants
+#define CHECKSUM_COLUMN_SEPARATOR       "  "        // Between line data and line checksum
+
+// Number column constants (leading spaces, digits)
+#define HEX_PLAIN_SPACES                1
+#define HEX_PLAIN_DIGITS                4
+#define OCTAL_BYTE_SPACES               1
+#define OCTAL_BYTE_DIGITS               3
+#define OCTAL_WORD_SPACES               2
+#define OCTAL_WORD_DIGITS               6
+#define DECIMAL_WORD_SPACES             3
+#define DECIMAL_WORD_DIGITS             5
+#define HEX_WORD_SPACES                 4
+#define HEX_WORD_DIGITS                 4
+#define BINARY_BYTE_SPACES              1
+#define BINARY_BYTE_DIGITS              8
+
+// Typed display constants (-t)
+#define TYPE_HEX                        'x'         // Hexadecimal
+#define TYPE_UNSIGNED                   'u'         // Unsigned decimal
+#define TYPE_SIGNED                     'd'         // Signed decimal
+#define TYPE_FLOAT                      'f'         // IEEE floating point
+#define TYPE_DEFAULT_SIZE               4           // Unit size unless stated
+#define TYPE_DEFAULT_FLOAT_SIZE         8           // Floating point unit size unless stated (double)
+#define TYPE_SPACES                     1           // Leading spaces of a column
+#define TYPE_ENDIAN_LITTLE              "le"        // Little endian (same as system endianness)
+#define TYPE_ENDIAN_BIG                 "be"        // Big endian (network byte order)
+#define TYPE_SWAP_BLOCK                 16          // Bytes swapped by one vector instruction
 
 // Canonical format constants
 #define CAN_HEX_SEPARATOR               ' '
 #define CAN_ASCII_SEPARATOR             "  "
-#define CAN_HEX_FORMAT                  " %02x"
+#define CAN_HEX_DIGITS                  2
 #define CAN_ASCII_FORMAT_NONASCII       '.'
 #define CAN_ASCII_FORMAT_BORDER         '|'
 
@@ -51,8 +100,22 @@ typedef unsigned char                   ubyte_t;
 // National DOS codepage low boundary
 #define ASCII_DOS_CP_BEGIN              0x80
 
+// UTF-8 sequence boundaries (-cu and -Cu)
+#define UTF8_CONTINUATION_LOW           0x80        // Lowest continuation byte
+#define UTF8_CONTINUATION_HIGH          0xbf        // Highest continuation byte
+#define UTF8_LEAD_2                     0xc2        // Lowest lead byte of two-byte sequence (0xc0 and 0xc1 are overlong)
+#define UTF8_LEAD_3                     0xe0        // Lowest lead byte of three-byte sequence
+#define UTF8_LEAD_4                     0xf0        // Lowest lead byte of four-byte sequence
+#define UTF8_LEAD_HIGHEST               0xf4        // Highest lead byte (code points up to U+10FFFF)
+#define UTF8_PRINTABLE_LOW              0xa0        // Lowest second byte after 0xc2 (U+0080 to U+009F are controls)
+#define UTF8_ASCII_MASK                 0x8080808080808080ULL   // High bits of eight bytes
+#define UTF8_CONTINUATION_MARK          "\xc2\xb7" // Middle dot in place of continuation bytes
+
 // Printable character display
 #define CHAR_BYTE_FORMAT_PRINTABLE      "   %c"
+#define CHAR_BYTE_FORMAT_OCTAL          " %03o"
+#define CHAR_BYTE_CELL                  4           // Characters per displayed byte
+#define CHAR_UTF8_INDENT                "   "       // Spaces before a UTF-8 character or continuation mark
 
 // Escape sequences
 #define CHAR_BYTE_FORMAT_ESCAPE_NULL    "  \\0"
@@ -74,53 +137,157 @@ typedef unsigned char                   ubyte_t;
 #define CHAR_BYTE_VALUE_FF              0x0c        // form feed
 #define CHAR_BYTE_VALUE_CR              0x0d        // carriage return
 
+// Dump options shared by all formats
+typedef struct dump_options {
+    bool verbose;                       // Display all input data (don't squeeze repeating lines)
+    int checksum;                       // Checksum algorithm (CHECKSUM_NONE if disabled)
+    size_t checksum_block;              // Checksum every <block> bytes (0 means every line)
+    size_t width;                       // Bytes per line
+    int output;                         // Output kind (OUTPUT_TEXT for human readable lines)
+    int encoding;                       // Data encoding of JSON and CSV records
+    size_t alignment;                   // Sector size of raw device input (1 for regular files)
+    size_t chunk_size;                  // Bytes read from file at once (DUMP_CHUNK_SIZE unless planned otherwise)
+    bool dedup;                         // Replace lines seen anywhere earlier with back-references
+} dump_options_t;
+
+// Line remembered for back-references
+typedef struct dump_seen {
+    uqword_t hash;                      // xxHash64 of line data
+    size_t position;                    // Offset of first line with the hash plus one (0 if slot is empty)
+} dump_seen_t;
+
+// Renderer of data columns of one line
+struct dump_format;
+typedef char* (*dump_render_t)(
+    const struct dump_format* format,
+    char* out,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
+);
+
+// Line format descriptor
+typedef struct dump_format {
+    size_t unit;                        // Bytes displayed in one column
+    size_t spaces;                      // Leading spaces of a column
+    size_t digits;                      // Zero-filled digits of a column
+    unsigned int base;                  // Number base of a column
+    dump_render_t render;               // Render data columns of any line
+    const dump_render_t* render_full;   // Render full lines of specialized widths
+    bool is_signed;                     // Units are signed numbers
+    bool is_float;                      // Units are floating point numbers
+    bool big_endian;                    // Units are stored in big endian
+} dump_format_t;
+
+// Dump state carried between pieces of input data
+typedef struct dump_state {
+    const dump_format_t* format;        // Line format
+    dump_render_t render_full;          // Full line renderer for chosen width
+    dump_options_t options;             // Dump options
+    FILE* out;                          // Output stream
+    size_t width;                       // Bytes per line
+    size_t ndigits;                     // Offset digits
+    size_t position;                    // Offset of next line
+    bool line_repeat;                   // Repeating line (asterisk already printed)
+    bool has_previous;                  // Previous full line is valid
+    ubyte_t previous[DUMP_MAX_LINE_WIDTH];  // Previous full line
+    ubyte_t pending[DUMP_MAX_LINE_WIDTH];   // Incomplete line waiting for more data
+    size_t pending_count;               // Bytes in incomplete line
+    char* buffer;                       // Output buffer
+    size_t buffered;                    // Characters in output buffer
+    checksum_t total_sum;               // Checksum of all data
+    checksum_t block_sum;               // Checksum of current block
+    size_t block_start;                 // Offset of current block
+    size_t block_count;                 // Bytes in current block
+    size_t begin;                       // Initial offset
+    dump_seen_t* seen;                  // Lines seen so far (behind output buffer, NULL without back-references)
+    size_t reference_begin;             // Offset of first line of pending back-reference
+    size_t reference_source;            // Offset of its earlier copy
+    size_t reference_lines;             // Lines of pending back-reference (0 if there is none)
+    size_t dedup_lines;                 // Lines replaced by back-references
+    size_t dedup_total;                 // Full lines looked up
+} dump_state_t;
+
+// Line formats
+extern const dump_format_t format_plain_hex;        // Plain hex
+extern const dump_format_t format_byte_octal;       // Byte octal
+extern const dump_format_t format_byte_binary;      // Byte binary
+extern const dump_format_t format_byte_char;        // Byte character
+extern const dump_format_t format_canonical;        // Hex-ascii canonical
+extern const dump_format_t format_byte_char_utf8;   // Byte character, UTF-8 sequences decoded
+extern const dump_format_t format_canonical_utf8;   // Hex-ascii canonical, UTF-8 sequences decoded
+extern const dump_format_t format_word_decimal;     // Word decimal
+extern const dump_format_t format_word_octal;       // Word octal
+extern const dump_format_t format_word_hex;         // Word hex
+
 // Declare functions
-int dump_plain_hex(
+void print_offset(
     FILE* file,
-    bool verbose,
+    size_t ndigits,
+    size_t position
+);       // Print offset
+size_t get_offset_digits(
+    uqword_t number
+);       // Calculate number of offset digits
+void dump_prepare(
+    void
+);       // Prepare line formats for rendering
+char* dump_render_line(
+    const dump_format_t* format,
+    char* out,
+    size_t ndigits,
+    uqword_t position,
+    const ubyte_t* data,
+    size_t count,
+    size_t width
+);       // Render offset and data columns of single line (without line feed)
+bool dump_parse_type(
+    const char* string,
+    dump_format_t* format
+);       // Set up typed display format from its specification (x, u, d or f, size, endianness)
+dump_render_t dump_full_renderer(
+    const dump_format_t* format,
+    size_t width
+);       // Pick full line renderer for given width
+bool dump_init(
+    dump_state_t* state,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    FILE* out,
     size_t offset,
-    size_t* position,
-    size_t endoffset
-);       // Dump plain hex
-int dump_byte_octal(
-    FILE* file,
-    bool verbose,
-    size_t* position,
-    size_t endoffset
-);      // Dump byte octal
-int dump_byte_char(
-    FILE* file,
-    bool verbose,
-    size_t offset,
-    size_t* position,
-    size_t endoffset
-);       // Dump byte character
-int dump_canonical(
-    FILE* file,
-    bool verbose,
-    size_t offset,
-    size_t* position,
-    size_t endoffset
-);       // Dump hex-ascii canonical
-int dump_word_decimal(
-    FILE* file,
-    bool verbose,
-    size_t* position,
     size_t endoffset
-);    // Dump word decimal
-int dump_word_octal(
+);       // Prepare dump of a range
+void dump_feed(
+    dump_state_t* state,
+    const ubyte_t* data,
+    size_t count
+);       // Dump next piece of input data
+void dump_skip(
+    dump_state_t* state,
+    size_t position
+);       // Continue dump further in file, leaving a marker in place of skipped data
+void dump_flush(
+    dump_state_t* state
+);       // Write buffered output
+void dump_end(
+    dump_state_t* state
+);       // Finish dump (incomplete line, ending offset and checksum)
+int dump_file(
     FILE* file,
-    bool verbose,
+    const dump_format_t* format,
+    const dump_options_t* options,
     size_t offset,
     size_t* position,
     size_t endoffset
-);      // Dump word octal
-int dump_word_hex(
+);       // Dump range of a file
+int dump_stream(
     FILE* file,
-    bool verbose,
+    FILE* out,
+    const dump_format_t* format,
+    const dump_options_t* options,
     size_t offset,
     size_t* position,
     size_t endoffset
-);        // Dump word hex
+);       // Dump range of a file to given stream (returns error code without reporting it)
 
 #endif
@@ -0,0 +1,378 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: extract.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// Classification instructions (SSE2 on x86, NEON on ARM64)
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#include <emmintrin.h>
+#define EXTRACT_VECTOR_X86
+#elif defined(_M_ARM64)
+#include <intrin.h>
+#include <arm_neon.h>
+#define EXTRACT_VECTOR_ARM
+#endif
+
+// Local definitions
+#include "extract.h"
+#include "dumps.h"
+#include "info.h"
+
+// Classify block of bytes, bit of each printable byte and of each zero byte is set - static function
+static uqword_t classify_block(const ubyte_t* data, uqword_t* zeros) {
+    uqword_t printable = 0;
+    *zeros = 0;
+
+#if defined(EXTRACT_VECTOR_X86)
+    // Bytes above 0x7f are negative as signed, so two signed comparisons bound the printable range
+    const __m128i low = _mm_set1_epi8(ASCII_LOWEST - 1);
+    const __m128i high = _mm_set1_epi8(ASCII_HIGHEST + 1);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (size_t i = 0; i < EXTRACT_BLOCK; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i inside = _mm_and_si128(_mm_cmpgt_epi8(bytes, low), _mm_cmplt_epi8(bytes, high));
+        printable |= (uqword_t)(unsigned int)_mm_movemask_epi8(inside) << i;
+        *zeros |= (uqword_t)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)) << i;
+    }
+#elif defined(EXTRACT_VECTOR_ARM)
+    // Lanes are weighted by their bit and pairwise added into one byte of mask per eight bytes
+    static const ubyte_t weights[16] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+    const uint8x16_t weight = vld1q_u8(weights);
+    uint8x16_t inside[4], zero[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        uint8x16_t bytes = vld1q_u8(data + 16 * i);
+        inside[i] = vandq_u8(vandq_u8(vcgeq_u8(bytes, vdupq_n_u8(ASCII_LOWEST)), vcleq_u8(bytes, vdupq_n_u8(ASCII_HIGHEST))), weight);
+        zero[i] = vandq_u8(vceqq_u8(bytes, vdupq_n_u8(0)), weight);
+    }
+
+    uint8x16_t sum = vpaddq_u8(vpaddq_u8(inside[0], inside[1]), vpaddq_u8(inside[2], inside[3]));
+    printable = vgetq_lane_u64(vreinterpretq_u64_u8(vpaddq_u8(sum, sum)), 0);
+    sum = vpaddq_u8(vpaddq_u8(zero[0], zero[1]), vpaddq_u8(zero[2], zero[3]));
+    *zeros = vgetq_lane_u64(vreinterpretq_u64_u8(vpaddq_u8(sum, sum)), 0);
+#else
+    for (size_t i = 0; i < EXTRACT_BLOCK; ++i) {
+        // One byte at a time
+        if (data[i] >= ASCII_LOWEST && data[i] <= ASCII_HIGHEST)
+            printable |= 1ULL << i;
+        if (data[i] == 0)
+            *zeros |= 1ULL << i;
+    }
+#endif
+
+    return printable;
+}
+
+// Get index of lowest set bit (mask must not be zero) - static function
+static size_t first_bit(uqword_t mask) {
+    unsigned long index;
+
+#if defined(_M_X64) || defined(_M_ARM64)
+    _BitScanForward64(&index, mask);
+#else
+    // 32-bit scans only
+    if (!_BitScanForward(&index, (unsigned long)mask)) {
+        _BitScanForward(&index, (unsigned long)(mask >> 32));
+        index += 32;
+    }
+#endif
+
+    return index;
+}
+
+// Keep only runs long enough to be displayed (or reaching the end of block) - static function
+static uqword_t long_runs(uqword_t characters, size_t minimum, size_t stride) {
+    // Starts of windows of characters (every <stride> bytes) are doubled up to
+    // the minimal length (bytes past the end of block count as characters), then
+    // every window is spread back over its characters, shorter runs inside the
+    // block disappear
+    uqword_t starts = characters;
+    size_t span = 1;
+    while (span < minimum && span * stride < EXTRACT_BLOCK) {
+        size_t step = (minimum - span < span) ? minimum - span : span;
+        if ((span + step) * stride > EXTRACT_BLOCK)
+            step = EXTRACT_BLOCK / stride - span;
+        starts &= (starts >> (step * stride)) | ~(~0ULL >> (step * stride));
+        span += step;
+    }
+
+    uqword_t covered = starts;
+    for (size_t spread = 1; spread < span;) {
+        size_t step = (span - spread < spread) ? span - spread : spread;
+        covered |= covered << (step * stride);
+        spread += step;
+    }
+
+    return characters & covered;
+}
+
+// Write buffered output - static function
+static void extract_flush(extract_state_t* state) {
+    fwrite(state->buffer, 1, state->buffered, state->out);
+    state->buffered = 0;
+}
+
+// Append characters to output - static function
+static void extract_put(extract_state_t* state, const char* text, size_t count) {
+    while (count > 0) {
+        // Long strings are written in pieces
+        if (state->buffered == EXTRACT_OUTPUT_SIZE)
+            extract_flush(state);
+
+        size_t take = EXTRACT_OUTPUT_SIZE - state->buffered;
+        if (take > count)
+            take = count;
+
+        memcpy(state->buffer + state->buffered, text, take);
+        state->buffered += take;
+        text += take;
+        count -= take;
+    }
+}
+
+// Add characters to run - static function
+static void extract_append(extract_state_t* state, extract_run_t* run, const char* text, size_t count, size_t position) {
+    // Format:
+    // Offset of first character
+    // 1 space
+    // String kind and 1 space (only with UTF-16LE strings)
+    // Characters of the run
+
+    if (run->count == 0)
+        run->begin = position;      // First characters of a run
+
+    if (!run->printing) {
+        if (run->count + count < state->minimum) {
+            // Run isn't long enough yet, keep its characters
+            memcpy(run->held + run->count, text, count);
+            run->count += count;
+            return;
+        }
+
+        // Run became long enough, print it out so far
+        char header[MAX_OFFSET_DIGITS + 4];
+        int length = sprintf(header, "%0*llx ", (int)state->ndigits, (unsigned long long)run->begin);
+        if (state->utf16)
+            length += sprintf(header + length, "%c ", run->kind);
+
+        extract_put(state, header, length);
+        extract_put(state, run->held, run->count);
+        run->printing = true;
+    }
+
+    // Characters of long enough run go straight to output
+    extract_put(state, text, count);
+    run->count += count;
+}
+
+// End run - static function
+static void extract_close(extract_state_t* state, extract_run_t* run) {
+    if (run->printing)
+        extract_put(state, "\n", 1);       // Issue end of line
+
+    run->count = 0;
+    run->printing = false;
+}
+
+// Process single byte - static function
+static void extract_byte(extract_state_t* state, const ubyte_t* data, size_t position) {
+    // Runs ended by the byte are closed before any run is added to,
+    // so that lines of different runs never mix
+    bool printable = *data >= ASCII_LOWEST && *data <= ASCII_HIGHEST;
+
+    if (!printable && state->ascii.count > 0)
+        extract_close(state, &state->ascii);
+
+    if (state->utf16) {
+        // UTF-16LE character is a printable low byte followed by a zero high byte,
+        // one run starts at even offsets, the other one at odd offsets
+        extract_run_t* low = &state->wide[position & 1];
+        extract_run_t* high = &state->wide[!(position & 1)];
+
+        if (high->has_low && *data == 0)
+            extract_append(state, high, &high->low, 1, position - 1);
+        else if (high->count > 0)
+            extract_close(state, high);
+        high->has_low = false;
+
+        if (printable) {
+            low->low = (char)*data;
+            low->has_low = true;
+        }
+        else if (low->count > 0)
+            extract_close(state, low);
+    }
+
+    if (printable)
+        extract_append(state, &state->ascii, (const char*)data, 1, position);
+}
+
+// Process whole block of ASCII characters - static function
+static void extract_ascii(extract_state_t* state, const ubyte_t* data, size_t position, uqword_t printable) {
+    size_t i = 0;
+
+    while (i < EXTRACT_BLOCK) {
+        uqword_t rest = printable >> i;
+
+        if (state->ascii.count == 0) {
+            // Skip to the next printable byte
+            if (rest == 0)
+                break;
+
+            i += first_bit(rest);
+            rest = printable >> i;
+        }
+
+        // Run goes on until the next byte that isn't printable (or the end of block)
+        size_t length = (~rest == 0) ? EXTRACT_BLOCK : first_bit(~rest);
+
+        if (state->ascii.count == 0 && i + length < EXTRACT_BLOCK && length < state->minimum) {
+            // Short run inside the block, nothing to keep
+            i += length;
+            continue;
+        }
+
+        extract_append(state, &state->ascii, (const char*)data + i, length, position + i);
+        i += length;
+
+        if (i < EXTRACT_BLOCK)
+            extract_close(state, &state->ascii);
+    }
+}
+
+// Process piece of input data - static function
+static void extract_feed(extract_state_t* state, const ubyte_t* data, size_t count, size_t position) {
+    size_t i = 0;
+
+    // Full blocks followed by at least one more byte (UTF-16LE characters look one byte ahead)
+    for (; i + EXTRACT_BLOCK < count; i += EXTRACT_BLOCK) {
+        uqword_t zeros;
+        uqword_t printable = classify_block(data + i, &zeros);
+
+        if (state->utf16) {
+            // Possible UTF-16LE strings (printable bytes followed by zeros) or open runs need byte by byte scan
+            if (data[i] != 0)
+                // Printable byte at the end of previous block isn't a UTF-16LE character
+                state->wide[0].has_low = state->wide[1].has_low = false;
+
+            uqword_t next = (zeros >> 1) | ((uqword_t)(data[i + EXTRACT_BLOCK] == 0) << (EXTRACT_BLOCK - 1));
+            bool wide = long_runs(printable & next, state->minimum, 2) != 0
+                || state->wide[0].count > 0 || state->wide[1].count > 0
+                || state->wide[0].has_low || state->wide[1].has_low;
+
+            if (wide) {
+                for (size_t j = 0; j < EXTRACT_BLOCK; ++j)
+                    extract_byte(state, data + i + j, position + i + j);
+                continue;
+            }
+        }
+
+        if (state->ascii.count > 0) {
+            // Run continued from previous block is kept whatever its length
+            uqword_t lead = (~printable == 0) ? ~0ULL : (1ULL << first_bit(~printable)) - 1;
+            printable = long_runs(printable, state->minimum, 1) | lead;
+        }
+        else
+            printable = long_runs(printable, state->minimum, 1);
+
+        if (printable == 0 && state->ascii.count == 0)
+            continue;       // Nothing long enough (most binary data)
+
+        extract_ascii(state, data + i, position + i, printable);
+    }
+
+    for (; i < count; ++i)
+        // Remaining bytes one at a time
+        extract_byte(state, data + i, position + i);
+}
+
+// Print runs of printable characters of at least given length with their offsets
+int extract_strings(
+    FILE* file,
+    size_t minimum,
+    bool utf16,
+    size_t chunk_size,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    int retcode = 0;
+
+    extract_state_t* state = malloc(sizeof(extract_state_t));
+    ubyte_t* chunk = malloc(chunk_size);
+    char* buffer = malloc(EXTRACT_OUTPUT_SIZE);
+
+    if (!state || !chunk || !buffer) {
+        // Not enough memory for buffers
+        free(state);
+        free(chunk);
+        free(buffer);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    memset(state, 0, sizeof(extract_state_t));
+    state->out = stdout;
+    state->ndigits = get_offset_digits(endoffset);     // Calculate number of digits based on ending offset
+    state->minimum = minimum;
+    state->utf16 = utf16;
+    state->ascii.kind = EXTRACT_KIND_ASCII;
+    state->wide[0].kind = state->wide[1].kind = EXTRACT_KIND_UTF16;
+    state->buffer = buffer;
+
+    while (*position < endoffset) {
+        // Read next chunk of the range
+        size_t count = (endoffset - *position < chunk_size) ? endoffset - *position : chunk_size;
+        size_t successfully_read = fread(chunk, BYTE_SIZE, count, file);
+
+        extract_feed(state, chunk, successfully_read, *position);
+        *position += successfully_read;
+
+        if (successfully_read < count) {
+            // An error occured while reading file, keep what was found so far
+            retcode = (errno != 0) ? errno : EIO;
+            extract_flush(state);
+            errno = retcode;
+            print_file_error("An error occured while file contents output");
+            break;
+        }
+    }
+
+    if (retcode == 0) {
+        // Runs reaching the end of range
+        extract_close(state, &state->ascii);
+        extract_close(state, &state->wide[0]);
+        extract_close(state, &state->wide[1]);
+
+        // Ending offset
+        char ending[MAX_OFFSET_DIGITS + 2];
+        extract_put(state, ending, sprintf(ending, "%0*llx\n", (int)state->ndigits, (unsigned long long)*position));
+        extract_flush(state);
+    }
+
+    // Tidy up
+    free(state);
+    free(chunk);
+    free(buffer);
+
+    return retcode;
+}
@@ -0,0 +1,67 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: extract.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for data types
+#ifndef __EXTRACT_H__
+#define __EXTRACT_H__
+
+// Define constants
+#define EXTRACT_MAX_LENGTH              4096        // Longest minimal string length
+#define EXTRACT_BLOCK                   64          // Bytes classified at once (one bit each)
+#define EXTRACT_OUTPUT_SIZE             65536       // Characters written to output at once
+#define EXTRACT_ENCODING_UTF16          "utf16"     // Modifier adding UTF-16LE strings (as given on command line)
+
+// String kinds (displayed with UTF-16LE strings only)
+#define EXTRACT_KIND_ASCII              'a'
+#define EXTRACT_KIND_UTF16              'u'
+
+// Run of printable characters
+typedef struct extract_run {
+    size_t begin;                       // Offset of first character
+    size_t count;                       // Characters so far (0 if there is no run)
+    bool printing;                      // Run is long enough and its characters are printed as they come
+    bool has_low;                       // Printable low byte waits for its high byte (UTF-16LE only)
+    char low;                           // That low byte
+    char kind;                          // String kind
+    char held[EXTRACT_MAX_LENGTH];      // Characters until the run is long enough
+} extract_run_t;
+
+// Extraction state
+typedef struct extract_state {
+    FILE* out;                          // Output stream
+    size_t ndigits;                     // Offset digits
+    size_t minimum;                     // Shortest string displayed
+    bool utf16;                         // Look for UTF-16LE strings as well
+    extract_run_t ascii;                // Run of ASCII characters
+    extract_run_t wide[2];              // Runs of UTF-16LE characters at even and odd offsets
+    char* buffer;                       // Output buffer
+    size_t buffered;                    // Characters in output buffer
+} extract_state_t;
+
+// Declare functions
+int extract_strings(
+    FILE* file,
+    size_t minimum,
+    bool utf16,
+    size_t chunk_size,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+);      // Print runs of printable characters of at least given length with their offsets
+
+#endif
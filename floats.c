@@ -0,0 +1,349 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: floats.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Local definitions
+#include "floats.h"
+
+// Number with 64-bit significand and binary exponent
+typedef struct diy_fp {
+    unsigned long long f;               // Significand
+    int e;                              // Binary exponent
+} diy_fp_t;
+
+// Normalized significands of cached powers of ten 10^-348, 10^-340, ..., 10^340
+static const unsigned long long cached_powers_f[FLOAT_CACHED_POWERS] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+// Binary exponents of cached powers of ten
+static const short cached_powers_e[FLOAT_CACHED_POWERS] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+// Powers of ten
+static const unsigned long long powers_of_ten[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+// Multiply two numbers (upper 64 bits of the product, rounded) - static function
+static diy_fp_t fp_multiply(diy_fp_t x, diy_fp_t y) {
+    unsigned long long a = x.f >> 32, b = x.f & 0xffffffff;
+    unsigned long long c = y.f >> 32, d = y.f & 0xffffffff;
+    unsigned long long ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    unsigned long long middle = (bd >> 32) + (ad & 0xffffffff) + (bc & 0xffffffff) + (1ULL << 31);
+
+    diy_fp_t product = { ac + (ad >> 32) + (bc >> 32) + (middle >> 32), x.e + y.e + 64 };
+    return product;
+}
+
+// Shift significand up to its highest bit - static function
+static diy_fp_t fp_normalize(diy_fp_t x) {
+    // Binary search for the highest bit (significand is never zero)
+    for (int shift = 32; shift > 0; shift /= 2) {
+        if (!(x.f >> (64 - shift))) {
+            x.f <<= shift;
+            x.e -= shift;
+        }
+    }
+    return x;
+}
+
+// Count decimal digits of a 32-bit number - static function
+static int count_digits(unsigned int number) {
+    int digits = 1;
+    while (digits < 10 && number >= powers_of_ten[digits])
+        ++digits;
+    return digits;
+}
+
+// Move last digit closer to the exact value - static function
+static void grisu_round(char* buffer, int length, unsigned long long delta, unsigned long long rest,
+                        unsigned long long ten_kappa, unsigned long long distance) {
+    while (rest < distance && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < distance || distance - rest > rest + ten_kappa - distance)) {
+        --buffer[length - 1];
+        rest += ten_kappa;
+    }
+}
+
+// Generate shortest digits within the boundaries - static function
+static int grisu_digits(diy_fp_t w, diy_fp_t upper, unsigned long long delta, char* buffer, int* k) {
+    diy_fp_t one = { 1ULL << -upper.e, upper.e };
+    unsigned long long distance = upper.f - w.f;
+    unsigned int integral = (unsigned int)(upper.f >> -one.e);
+    unsigned long long fraction = upper.f & (one.f - 1);
+    int kappa = count_digits(integral);
+    int length = 0;
+
+    while (kappa > 0) {
+        // Digits of the integral part (constant divisors are turned into multiplications)
+        unsigned int digit;
+        switch (kappa) {
+        case 10: digit = integral / 1000000000; integral %= 1000000000; break;
+        case 9:  digit = integral / 100000000;  integral %= 100000000;  break;
+        case 8:  digit = integral / 10000000;   integral %= 10000000;   break;
+        case 7:  digit = integral / 1000000;    integral %= 1000000;    break;
+        case 6:  digit = integral / 100000;     integral %= 100000;     break;
+        case 5:  digit = integral / 10000;      integral %= 10000;      break;
+        case 4:  digit = integral / 1000;       integral %= 1000;       break;
+        case 3:  digit = integral / 100;        integral %= 100;        break;
+        case 2:  digit = integral / 10;         integral %= 10;         break;
+        default: digit = integral;              integral = 0;
+        }
+        if (digit || length)
+            buffer[length++] = (char)('0' + digit);
+        --kappa;
+
+        unsigned long long rest = ((unsigned long long)integral << -one.e) + fraction;
+        if (rest <= delta) {
+            // Enough digits to stay within the boundaries
+            *k += kappa;
+            grisu_round(buffer, length, delta, rest, powers_of_ten[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    for (;;) {
+        // Digits of the fractional part
+        fraction *= 10;
+        delta *= 10;
+        char digit = (char)(fraction >> -one.e);
+        if (digit || length)
+            buffer[length++] = (char)('0' + digit);
+        fraction &= one.f - 1;
+        --kappa;
+
+        if (fraction < delta) {
+            // Enough digits to stay within the boundaries
+            *k += kappa;
+            grisu_round(buffer, length, delta, fraction, one.f, distance * ((-kappa < 20) ? powers_of_ten[-kappa] : 0));
+            return length;
+        }
+    }
+}
+
+// Shortest digits of a finite positive number (Grisu2) - static function
+static int grisu2(unsigned long long significand, int exponent, bool lower_closer, char* buffer, int* k) {
+    // Boundaries halfway to the neighbouring values, lower one is closer
+    // when the significand is the lowest of its binary exponent
+    diy_fp_t value = { significand, exponent };
+    diy_fp_t upper = fp_normalize((diy_fp_t){ (significand << 1) + 1, exponent - 1 });
+    diy_fp_t lower = (lower_closer) ? (diy_fp_t){ (significand << 2) - 1, exponent - 2 }
+                                    : (diy_fp_t){ (significand << 1) - 1, exponent - 1 };
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    // Cached power of ten bringing the upper boundary exponent into [-60, -32]
+    double dk = (-61 - upper.e) * 0.30102999566398114 + 347;
+    int power = (int)dk;
+    if (dk - power > 0.0)
+        ++power;
+    int index = (power >> 3) + 1;
+    diy_fp_t cached = { cached_powers_f[index], cached_powers_e[index] };
+    *k = -(-348 + index * 8);
+
+    diy_fp_t w = fp_multiply(fp_normalize(value), cached);
+    diy_fp_t w_upper = fp_multiply(upper, cached);
+    diy_fp_t w_lower = fp_multiply(lower, cached);
+
+    // Stay safely inside the boundaries
+    ++w_lower.f;
+    --w_upper.f;
+
+    return grisu_digits(w, w_upper, w_upper.f - w_lower.f, buffer, k);
+}
+
+// Write exponent of scientific notation - static function
+static char* put_exponent(char* out, int exponent) {
+    *out++ = 'e';
+    *out++ = (exponent < 0) ? '-' : '+';
+    if (exponent < 0)
+        exponent = -exponent;
+
+    // At least two digits
+    if (exponent >= 100)
+        *out++ = (char)('0' + exponent / 100);
+    *out++ = (char)('0' + exponent / 10 % 10);
+    *out++ = (char)('0' + exponent % 10);
+    return out;
+}
+
+// Lay out digits in decimal or scientific notation - static function
+static int layout_digits(char* out, const char* digits, int length, int k, int max_digits) {
+    // Value is 0.<digits> * 10^point
+    int point = length + k;
+    char* begin = out;
+
+    if (point > 0 && point <= max_digits) {
+        // Decimal notation with integral part
+        if (point >= length) {
+            // Whole number (trailing zeros are added)
+            memcpy(out, digits, length);
+            memset(out + length, '0', point - length);
+            out += point;
+        }
+        else {
+            memcpy(out, digits, point);
+            out += point;
+            *out++ = '.';
+            memcpy(out, digits + point, length - point);
+            out += length - point;
+        }
+    }
+    else if (point <= 0 && point > FLOAT_MIN_DECIMAL_POINT) {
+        // Decimal notation with leading zeros
+        *out++ = '0';
+        *out++ = '.';
+        memset(out, '0', -point);
+        out += -point;
+        memcpy(out, digits, length);
+        out += length;
+    }
+    else {
+        // Scientific notation
+        *out++ = digits[0];
+        if (length > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, length - 1);
+            out += length - 1;
+        }
+        out = put_exponent(out, point - 1);
+    }
+
+    return (int)(out - begin);
+}
+
+// Write number right-aligned to a column - static function
+static char* put_column(char* out, size_t width, bool negative, const char* text, int length) {
+    // Text fits in the column (widths are chosen for the longest output)
+    size_t used = length + (negative ? 1 : 0);
+    if (used < width) {
+        memset(out, ' ', width - used);
+        out += width - used;
+    }
+
+    if (negative)
+        *out++ = '-';
+    memcpy(out, text, length);
+
+    return out + length;
+}
+
+// Format double precision number
+char* format_double(char* out, double value, size_t width) {
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    bool negative = (bits >> 63) != 0;
+    int biased = (int)((bits >> FLOAT_DOUBLE_MANTISSA) & 0x7ff);
+    unsigned long long mantissa = bits & ((1ULL << FLOAT_DOUBLE_MANTISSA) - 1);
+
+    if (biased == 0x7ff) {
+        // Infinity or not a number
+        if (mantissa)
+            return put_column(out, width, false, FLOAT_NAN, sizeof(FLOAT_NAN) - 1);
+        return put_column(out, width, negative, FLOAT_INFINITY, sizeof(FLOAT_INFINITY) - 1);
+    }
+    if (biased == 0 && mantissa == 0)
+        // Zero (keeps its sign)
+        return put_column(out, width, negative, "0", 1);
+
+    // Significand with hidden bit (subnormal numbers have none)
+    unsigned long long significand = (biased) ? mantissa | (1ULL << FLOAT_DOUBLE_MANTISSA) : mantissa;
+    int exponent = ((biased) ? biased : 1) - FLOAT_DOUBLE_BIAS - FLOAT_DOUBLE_MANTISSA;
+
+    char digits[FLOAT_MAX_DIGITS], text[FLOAT_MAX_TEXT];
+    int k;
+    int length = grisu2(significand, exponent, mantissa == 0 && biased > 1, digits, &k);
+    length = layout_digits(text, digits, length, k, FLOAT_DOUBLE_DIGITS);
+
+    return put_column(out, width, negative, text, length);
+}
+
+// Format single precision number
+char* format_float(char* out, float value, size_t width) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    bool negative = (bits >> 31) != 0;
+    int biased = (int)((bits >> FLOAT_SINGLE_MANTISSA) & 0xff);
+    unsigned int mantissa = bits & ((1U << FLOAT_SINGLE_MANTISSA) - 1);
+
+    if (biased == 0xff) {
+        // Infinity or not a number
+        if (mantissa)
+            return put_column(out, width, false, FLOAT_NAN, sizeof(FLOAT_NAN) - 1);
+        return put_column(out, width, negative, FLOAT_INFINITY, sizeof(FLOAT_INFINITY) - 1);
+    }
+    if (biased == 0 && mantissa == 0)
+        // Zero (keeps its sign)
+        return put_column(out, width, negative, "0", 1);
+
+    // Boundaries are those of single precision, so the digits are the shortest
+    // ones reading back as the same single precision number
+    unsigned long long significand = (biased) ? mantissa | (1U << FLOAT_SINGLE_MANTISSA) : mantissa;
+    int exponent = ((biased) ? biased : 1) - FLOAT_SINGLE_BIAS - FLOAT_SINGLE_MANTISSA;
+
+    char digits[FLOAT_MAX_DIGITS], text[FLOAT_MAX_TEXT];
+    int k;
+    int length = grisu2(significand, exponent, mantissa == 0 && biased > 1, digits, &k);
+    length = layout_digits(text, digits, length, k, FLOAT_SINGLE_DIGITS);
+
+    return put_column(out, width, negative, text, length);
+}
@@ -0,0 +1,57 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: floats.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stddef.h>                     // Measure for size type
+#ifndef __FLOATS_H__
+#define __FLOATS_H__
+
+// IEEE 754 layouts
+#define FLOAT_SINGLE_MANTISSA           23          // Stored mantissa bits of single precision
+#define FLOAT_SINGLE_BIAS               127         // Exponent bias of single precision
+#define FLOAT_DOUBLE_MANTISSA           52          // Stored mantissa bits of double precision
+#define FLOAT_DOUBLE_BIAS               1023        // Exponent bias of double precision
+
+// Shortest digits conversion
+#define FLOAT_CACHED_POWERS             87          // Cached powers of ten (every 8th from 10^-348)
+#define FLOAT_MAX_DIGITS                20          // Most digits generated
+#define FLOAT_MAX_TEXT                  32          // Longest formatted number
+
+// Notation limits (decimal notation is used for exponents in between)
+#define FLOAT_SINGLE_DIGITS             9           // Significant digits of single precision
+#define FLOAT_DOUBLE_DIGITS             17          // Significant digits of double precision
+#define FLOAT_MIN_DECIMAL_POINT         -4          // Smallest numbers in decimal notation are above 1e-4
+
+// Column widths (longest formatted number including sign)
+#define FLOAT_SINGLE_COLUMN             15
+#define FLOAT_DOUBLE_COLUMN             24
+
+// Special values
+#define FLOAT_NAN                       "nan"
+#define FLOAT_INFINITY                  "inf"
+
+// Declare functions
+char* format_float(
+    char* out,
+    float value,
+    size_t width
+);      // Format single precision number with shortest round-trip digits, right-aligned to width
+char* format_double(
+    char* out,
+    double value,
+    size_t width
+);      // Format double precision number with shortest round-trip digits, right-aligned to width
+
+#endif
@@ -0,0 +1,251 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: follow.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <windows.h>
+
+// Local definitions
+#include "follow.h"
+#include "dumps.h"
+#include "info.h"
+
+// Event signalled by console control handler
+static HANDLE follow_stop_event = NULL;
+
+// Console control handler - static function
+static BOOL WINAPI follow_ctrl_handler(DWORD type) {
+    // Ctrl+C, Ctrl+Break or closing the console stops following,
+    // the dump is finished properly by the main thread
+    SetEvent(follow_stop_event);
+    return TRUE;
+}
+
+// Get directory of a file path - static function
+static void get_directory(const char* path, char* directory, size_t size) {
+    // Directory part ends with the last backslash, slash or drive colon
+    const char* end = NULL;
+    for (const char* c = path; *c != 0; ++c) {
+        if (*c == '\\' || *c == '/' || *c == ':')
+            end = c + 1;
+    }
+
+    if (!end || (size_t)(end - path) >= size) {
+        // No directory stated (or too long to be copied) -> current directory
+        strcpy(directory, ".");
+        return;
+    }
+
+    memcpy(directory, path, end - path);
+    directory[end - path] = 0;
+}
+
+// Get current size of a file (64-bit, followed logs easily grow past 2 GiB) - static function
+static bool get_file_size(FILE* file, size_t* fsize) {
+    if (_fseeki64(file, 0, SEEK_END) != 0)
+        return false;
+
+    long long size = _ftelli64(file);
+    if (size < 0)
+        // Size cannot be told
+        return false;
+
+    *fsize = (size_t)size;
+    return true;
+}
+
+// Dump data appended to file since last time - static function
+static bool follow_read(
+    FILE* file,
+    dump_state_t* state,
+    ubyte_t* chunk,
+    size_t* position,
+    size_t end
+) {
+    // Seeking drops any stale end of file state of the stream
+    if (_fseeki64(file, (long long)*position, SEEK_SET) != 0)
+        return false;
+
+    // Offset column grows with the file
+    size_t ndigits = get_offset_digits(end);
+    if (ndigits > state->ndigits)
+        state->ndigits = ndigits;
+
+    while (*position < end) {
+        // Read next chunk of appended data
+        size_t count = (end - *position < DUMP_CHUNK_SIZE) ? end - *position : DUMP_CHUNK_SIZE;
+        size_t successfully_read = fread(chunk, BYTE_SIZE, count, file);
+
+        dump_feed(state, chunk, successfully_read);
+        *position += successfully_read;
+
+        if (successfully_read < count)
+            // An error occured while reading file
+            return false;
+    }
+
+    // New lines appear right away
+    dump_flush(state);
+    fflush(state->out);
+
+    return true;
+}
+
+// Dump range of a file and keep dumping data appended to it
+int follow_file(
+    FILE* file,
+    const char* path,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    dump_state_t state;
+    char directory[FOLLOW_MAX_DIRECTORY];
+    ubyte_t* chunk = malloc(DUMP_CHUNK_SIZE);
+    size_t fsize;
+
+    if (!get_file_size(file, &fsize)) {
+        // Size of file cannot be told
+        free(chunk);
+        print_file_error("File cannot be followed");
+
+        return (errno != 0) ? errno : EIO;
+    }
+
+    // Offset column starts as wide as the data already in file
+    if (!chunk || !dump_init(&state, format, options, stdout, offset, (fsize < endoffset) ? fsize : endoffset)) {
+        // Not enough memory for buffers
+        free(chunk);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    // Writes to the file show up as size and last write changes of its directory,
+    // waiting for those doesn't cost any processor time
+    get_directory(path, directory, sizeof(directory));
+    HANDLE change = FindFirstChangeNotificationA(directory, FALSE, FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    DWORD error = (change == INVALID_HANDLE_VALUE) ? GetLastError() : ERROR_SUCCESS;
+    follow_stop_event = CreateEventA(NULL, TRUE, FALSE, NULL);
+    if (!follow_stop_event && error == ERROR_SUCCESS)
+        error = GetLastError();
+
+    if (change == INVALID_HANDLE_VALUE || !follow_stop_event) {
+        // Directory cannot be watched (Windows error is told by errno like any other)
+        if (change != INVALID_HANDLE_VALUE)
+            FindCloseChangeNotification(change);
+        if (follow_stop_event)
+            CloseHandle(follow_stop_event);
+        follow_stop_event = NULL;
+        free(state.buffer);
+        free(chunk);
+
+        switch (error) {
+        case ERROR_ACCESS_DENIED:
+            errno = EACCES;
+            break;
+        case ERROR_FILE_NOT_FOUND:
+        case ERROR_PATH_NOT_FOUND:
+            errno = ENOENT;
+            break;
+        case ERROR_NOT_ENOUGH_MEMORY:
+        case ERROR_OUTOFMEMORY:
+            errno = ENOMEM;
+            break;
+        default:
+            errno = EIO;
+            break;
+        }
+        print_file_error("File cannot be followed");
+
+        return errno;
+    }
+
+    SetConsoleCtrlHandler(follow_ctrl_handler, TRUE);
+
+    int retcode = 0;
+    HANDLE handles[2] = { follow_stop_event, change };
+
+    while (*position < endoffset) {
+        // Dump whatever was appended since last time
+        if (!get_file_size(file, &fsize)) {
+            // Size of file cannot be told
+            dump_flush(&state);
+
+            putchar('\n');      // Divide space between data and error message
+            print_file_error("An error occured while file contents output");
+
+            retcode = (errno != 0) ? errno : EIO;
+            break;
+        }
+
+        if (fsize < *position) {
+            // File was truncated, there is nothing left to follow
+            dump_flush(&state);
+            fprintf(stderr, "File was truncated, following stopped\n");
+            break;
+        }
+
+        if (!follow_read(file, &state, chunk, position, (fsize < endoffset) ? fsize : endoffset)) {
+            // An error occured while reading file
+            dump_flush(&state);
+
+            putchar('\n');      // Divide space between data and error message
+            print_file_error("An error occured while file contents output");
+
+            retcode = (errno != 0) ? errno : EIO;   // End with specific return code for given error
+            break;
+        }
+
+        if (*position >= endoffset)
+            // Whole requested length was dumped
+            break;
+
+        // Sleep until the directory changes or user stops following, file size is checked
+        // once in a while anyway because size of a file kept open by its writer may be
+        // reported to the directory with a delay
+        DWORD signalled = WaitForMultipleObjects(2, handles, FALSE, FOLLOW_RECHECK_INTERVAL);
+
+        if (signalled == WAIT_OBJECT_0)
+            // Stopped by user
+            break;
+        if (signalled == WAIT_OBJECT_0 + 1)
+            // Watch for next change
+            FindNextChangeNotification(change);
+    }
+
+    // Tidy up
+    SetConsoleCtrlHandler(follow_ctrl_handler, FALSE);
+    FindCloseChangeNotification(change);
+    CloseHandle(follow_stop_event);
+    follow_stop_event = NULL;
+    free(chunk);
+
+    if (retcode != 0) {
+        // Dump was broken by an error
+        free(state.buffer);
+        return retcode;
+    }
+
+    // Incomplete line and ending offset
+    dump_end(&state);
+
+    return 0;
+}
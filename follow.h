@@ -0,0 +1,37 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: follow.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                     // Measure for file descriptor
+#include "dumps.h"                     // Measure for dump format and options
+#ifndef __FOLLOW_H__
+#define __FOLLOW_H__
+
+// Define constants
+#define FOLLOW_RECHECK_INTERVAL         1000        // Milliseconds between size checks without notification
+#define FOLLOW_MAX_DIRECTORY            4096        // Longest directory path watched for changes
+
+// Declare functions
+int follow_file(
+    FILE* file,
+    const char* path,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+);      // Dump range of a file and keep dumping data appended to it
+
+#endif
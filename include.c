@@ -0,0 +1,223 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: include.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <ctype.h>
+
+// Local definitions
+#include "include.h"
+#include "dumps.h"
+#include "info.h"
+#include "workers.h"
+
+// Rendered entry of every byte value, "0xNN, " followed by two spare characters (filled on first use)
+static char entries[256][INCLUDE_ENTRY_STORE];
+static bool entries_ready = false;
+
+// Fill entries of all byte values - static function
+static void init_entries(void) {
+    static const char digits[] = "0123456789abcdef";
+
+    if (entries_ready)
+        return;
+
+    for (int i = 0; i < 256; ++i) {
+        memcpy(entries[i], "0x", 2);
+        entries[i][2] = digits[i >> 4];
+        entries[i][3] = digits[i & 0x0f];
+        memcpy(entries[i] + 4, ", ", 2);
+        entries[i][6] = entries[i][7] = ' ';
+    }
+
+    entries_ready = true;
+}
+
+// Get array name from file name (other characters than letters and digits become underscores) - static function
+static void get_array_name(const char* path, char* name) {
+    // File name follows the last backslash, slash or drive colon
+    const char* base = path;
+    for (const char* c = path; *c != 0; ++c) {
+        if (*c == '\\' || *c == '/' || *c == ':')
+            base = c + 1;
+    }
+
+    size_t length = 0;
+    if (isdigit((unsigned char)*base)) {
+        // Identifier can't begin with a digit
+        memcpy(name, "__", 2);
+        length = 2;
+    }
+
+    for (; *base != 0 && length < INCLUDE_MAX_NAME - 1; ++base)
+        name[length++] = (isalnum((unsigned char)*base)) ? *base : '_';
+
+    name[length] = 0;
+}
+
+// Render lines of a job, each at its own place - static function
+static void render_job(include_job_t* job) {
+    for (size_t line = job->first; line < job->last; ++line) {
+        // Last line of the chunk may be incomplete
+        size_t begin = line * job->width;
+        size_t count = job->count - begin;
+        if (count > job->width)
+            count = job->width;
+
+        const ubyte_t* data = job->data + begin;
+        char* out = job->text + line * job->line_length;
+        memcpy(out, INCLUDE_INDENT, sizeof(INCLUDE_INDENT) - 1);
+        out += sizeof(INCLUDE_INDENT) - 1;
+
+        // Whole entries are stored at once, spare characters are overwritten by next entry
+        for (size_t i = 0; i + 1 < count; ++i) {
+            memcpy(out, entries[data[i]], INCLUDE_ENTRY_STORE);
+            out += INCLUDE_ENTRY_LENGTH;
+        }
+
+        // Last entry stays within the line (next line may belong to another worker)
+        memcpy(out, entries[data[count - 1]], INCLUDE_ENTRY_LENGTH);
+        out[INCLUDE_ENTRY_LENGTH - 1] = '\n';
+    }
+}
+
+// Worker thread routine - static function
+static unsigned int __stdcall include_worker(void* context) {
+    render_job((include_job_t*)context);
+    return 0;
+}
+
+// Print range of a file as C array declaration with its length
+int include_file(
+    FILE* file,
+    const char* path,
+    size_t width,
+    unsigned int workers,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    int retcode = 0;
+    char* name = malloc(INCLUDE_MAX_NAME);
+
+    // Every full line has the same length, so each worker knows where its lines go
+    size_t line_length = sizeof(INCLUDE_INDENT) - 1 + width * INCLUDE_ENTRY_LENGTH;
+    size_t chunk_size = INCLUDE_CHUNK_SIZE - INCLUDE_CHUNK_SIZE % width;
+    size_t chunk_lines = chunk_size / width;
+
+    // Two buffers, so that next chunk can be read while workers render current one
+    ubyte_t* buffers[2];
+    buffers[0] = malloc(chunk_size);
+    buffers[1] = malloc(chunk_size);
+    char* text = malloc(chunk_lines * line_length);
+    include_job_t* jobs = malloc(MAX_WORKERS * sizeof(include_job_t));
+
+    if (!name || !buffers[0] || !buffers[1] || !text || !jobs) {
+        // Not enough memory for buffers
+        print_error_memory("Out of memory");
+
+        retcode = ENOMEM;
+        goto tidy_up;
+    }
+
+    init_entries();
+    get_array_name(path, name);
+    fprintf(stdout, INCLUDE_HEADER_FORMAT, name);
+
+    // Read first chunk
+    size_t current = 0;
+    size_t count = (endoffset - *position < chunk_size) ? endoffset - *position : chunk_size;
+
+    if (fread(buffers[current], BYTE_SIZE, count, file) < count) {
+        // An error occured while reading file
+        retcode = (errno != 0) ? errno : EIO;
+        errno = retcode;
+        print_file_error("An error occured while file contents output");
+
+        goto tidy_up;
+    }
+
+    while (count > 0) {
+        size_t nlines = (count + width - 1) / width;
+        workers_t running;
+        running.count = 0;
+
+        // Split lines of the chunk evenly between workers
+        unsigned int njobs = (nlines < workers) ? (unsigned int)nlines : workers;
+        for (unsigned int i = 0; i < njobs; ++i) {
+            jobs[i].data = buffers[current];
+            jobs[i].count = count;
+            jobs[i].width = width;
+            jobs[i].line_length = line_length;
+            jobs[i].text = text;
+            jobs[i].first = nlines * i / njobs;
+            jobs[i].last = nlines * (i + 1) / njobs;
+        }
+
+        if (njobs < 2 || !workers_start(&running, njobs, include_worker, jobs, sizeof(include_job_t))) {
+            // Single worker (or threads unavailable) -> render on this thread
+            jobs[0].first = 0;
+            jobs[0].last = nlines;
+            render_job(&jobs[0]);
+        }
+
+        // Read next chunk while workers are busy
+        size_t next_position = *position + count;
+        size_t next_count = (endoffset - next_position < chunk_size) ? endoffset - next_position : chunk_size;
+        size_t next_read = fread(buffers[!current], BYTE_SIZE, next_count, file);
+
+        workers_wait(&running);
+
+        // Last line may be incomplete, the last entry of all has no comma
+        size_t rest = count % width;
+        size_t length = (count / width) * line_length + ((rest > 0) ? sizeof(INCLUDE_INDENT) - 1 + rest * INCLUDE_ENTRY_LENGTH : 0);
+        if (next_count == 0) {
+            text[length - 2] = '\n';
+            --length;
+        }
+        fwrite(text, 1, length, stdout);
+
+        // Get new position from number of rendered bytes
+        *position = next_position;
+
+        if (next_read < next_count) {
+            // An error occured while reading file
+            retcode = (errno != 0) ? errno : EIO;
+            errno = retcode;
+            print_file_error("An error occured while file contents output");
+
+            goto tidy_up;
+        }
+
+        // Swap buffers
+        current = !current;
+        count = next_count;
+    }
+
+    // Array ends with its length
+    fprintf(stdout, INCLUDE_FOOTER_FORMAT, name, (unsigned long long)(endoffset - offset));
+
+    tidy_up:
+    free(name);
+    free(buffers[0]);
+    free(buffers[1]);
+    free(text);
+    free(jobs);
+
+    return retcode;
+}
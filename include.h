@@ -0,0 +1,57 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: include.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for data types
+#ifndef __INCLUDE_H__
+#define __INCLUDE_H__
+
+// Define constants
+#define INCLUDE_DEFAULT_WIDTH           12          // Bytes per line unless stated otherwise (same as xxd -i)
+#define INCLUDE_CHUNK_SIZE              4194304     // Input bytes rendered at once (rounded down to whole lines)
+#define INCLUDE_ENTRY_LENGTH            6           // Characters of one byte ("0xNN, ")
+#define INCLUDE_ENTRY_STORE             8           // Characters stored at once (the rest is overwritten by next byte)
+#define INCLUDE_MAX_NAME                4096        // Longest array name
+
+// Output format (same as xxd -i)
+#define INCLUDE_INDENT                  "  "
+#define INCLUDE_HEADER_FORMAT           "unsigned char %s[] = {\n"
+#define INCLUDE_FOOTER_FORMAT           "};\nunsigned int %s_len = %llu;\n"
+
+// Lines of a chunk rendered by one worker
+typedef struct include_job {
+    const ubyte_t* data;                // Chunk data
+    size_t count;                       // Bytes of chunk
+    size_t width;                       // Bytes per line
+    size_t line_length;                 // Characters of a full line
+    char* text;                         // Rendered chunk (every line at its own place)
+    size_t first;                       // First line of this job
+    size_t last;                        // Line after the last one of this job
+} include_job_t;
+
+// Declare functions
+int include_file(
+    FILE* file,
+    const char* path,
+    size_t width,
+    unsigned int workers,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+);      // Print range of a file as C array declaration with its length
+
+#endif
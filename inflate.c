@@ -0,0 +1,473 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: inflate.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// Local definitions
+#include "inflate.h"
+#include "dumps.h"
+
+// Base lengths and extra bits of length codes 257 to 285
+static const uword_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const ubyte_t length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// Base distances and extra bits of distance codes 0 to 29
+static const uword_t distance_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const ubyte_t distance_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// Order of code length code lengths in dynamic block header
+static const ubyte_t length_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+// Read next piece of compressed data once input buffer is used up - static function
+static bool refill(inflate_stream_t* stream) {
+    if (stream->input_position < stream->input_count)
+        return true;        // Input buffer still has some bytes
+
+    size_t count = (stream->left < INFLATE_INPUT_SIZE) ? (size_t)stream->left : INFLATE_INPUT_SIZE;
+    size_t successfully_read = (count > 0) ? fread(stream->input, BYTE_SIZE, count, stream->file) : 0;
+
+    if (successfully_read < count && ferror(stream->file) && stream->error == 0)
+        // An error occured while reading file
+        stream->error = (errno != 0) ? errno : EIO;
+
+    // Input ends early if the file is shorter than stated
+    stream->left = (successfully_read < count) ? 0 : stream->left - successfully_read;
+    stream->input_position = 0;
+    stream->input_count = successfully_read;
+
+    return successfully_read > 0;
+}
+
+// Load bits until at least given number of them is available - static function
+static bool need(inflate_stream_t* stream, size_t count) {
+    while (stream->bit_count < count) {
+        if (!refill(stream))
+            return false;       // Compressed data ends
+
+        stream->bits |= (uqword_t)stream->input[stream->input_position++] << stream->bit_count;
+        stream->bit_count += 8;
+    }
+
+    return true;
+}
+
+// Take given number of bits (16 at most) - static function
+static unsigned int take(inflate_stream_t* stream, size_t count) {
+    if (!need(stream, count)) {
+        // Compressed data ends in the middle of a block
+        if (stream->error == 0)
+            stream->error = EILSEQ;
+
+        return 0;
+    }
+
+    unsigned int value = (unsigned int)(stream->bits & ((1ULL << count) - 1));
+    stream->bits >>= count;
+    stream->bit_count -= count;
+
+    return value;
+}
+
+// Build decoding tables of a canonical code from code lengths of its symbols - static function
+static bool build(inflate_huffman_t* code, const ubyte_t* lengths, size_t count) {
+    uword_t offsets[INFLATE_MAX_BITS + 1];
+
+    memset(code->count, 0, sizeof(code->count));
+    memset(code->fast, 0, sizeof(code->fast));
+
+    for (size_t i = 0; i < count; ++i)
+        // Count codes of each length
+        ++code->count[lengths[i]];
+
+    int left = 1;
+    for (size_t length = 1; length <= INFLATE_MAX_BITS; ++length) {
+        // Each length doubles the number of possible codes, more codes than there is room for is an error
+        left = left * 2 - code->count[length];
+        if (left < 0)
+            return false;
+    }
+
+    offsets[1] = 0;
+    for (size_t length = 1; length < INFLATE_MAX_BITS; ++length)
+        // First symbol of each code length
+        offsets[length + 1] = offsets[length] + code->count[length];
+
+    for (size_t i = 0; i < count; ++i) {
+        // Symbols sorted by length, then by their own value
+        if (lengths[i] > 0)
+            code->symbol[offsets[lengths[i]]++] = (uword_t)i;
+    }
+
+    // Short codes are looked up by next input bits (stored lowest bit first, codes are read highest bit first)
+    unsigned int value = 0;
+    size_t index = 0;
+    for (size_t length = 1; length <= INFLATE_FAST_BITS; ++length) {
+        for (size_t i = 0; i < code->count[length]; ++i) {
+            unsigned int reversed = 0;
+            for (size_t bit = 0; bit < length; ++bit)
+                reversed |= ((value >> bit) & 1) << (length - 1 - bit);
+
+            for (size_t entry = reversed; entry < (1 << INFLATE_FAST_BITS); entry += (size_t)1 << length)
+                // Every combination of bits following the code
+                code->fast[entry] = (uword_t)(code->symbol[index] | length << INFLATE_FAST_BITS);
+
+            ++value;
+            ++index;
+        }
+
+        value <<= 1;
+    }
+
+    return true;
+}
+
+// Decode next symbol - static function
+static int decode(inflate_stream_t* stream, const inflate_huffman_t* code) {
+    if (need(stream, INFLATE_FAST_BITS)) {
+        // Short code takes a single lookup
+        uword_t entry = code->fast[stream->bits & ((1 << INFLATE_FAST_BITS) - 1)];
+        if (entry != 0) {
+            size_t length = entry >> INFLATE_FAST_BITS;
+            stream->bits >>= length;
+            stream->bit_count -= length;
+
+            return entry & ((1 << INFLATE_FAST_BITS) - 1);
+        }
+    }
+
+    // Long code (or the last bits of input) are decoded bit by bit
+    int value = 0;
+    int first = 0;
+    int index = 0;
+    for (size_t length = 1; length <= INFLATE_MAX_BITS; ++length) {
+        value |= take(stream, 1);
+        if (stream->error != 0)
+            return INFLATE_NO_SYMBOL;
+
+        int count = code->count[length];
+        if (value - first < count)
+            return code->symbol[index + value - first];     // Code of this length
+
+        index += count;
+        first = (first + count) << 1;
+        value <<= 1;
+    }
+
+    return INFLATE_NO_SYMBOL;       // Code isn't complete
+}
+
+// Hand new output over to sink, keep window of last output for back-references - static function
+static void hand_over(inflate_stream_t* stream) {
+    if (stream->output_position > stream->handed && !stream->stopped) {
+        if (!stream->sink(stream->context, stream->output + stream->handed, stream->output_position - stream->handed))
+            stream->stopped = true;     // Sink doesn't want any more
+    }
+
+    if (stream->output_position > INFLATE_WINDOW) {
+        // Back-references reach the window at most
+        memmove(stream->output, stream->output + stream->output_position - INFLATE_WINDOW, INFLATE_WINDOW);
+        stream->output_position = INFLATE_WINDOW;
+    }
+
+    stream->handed = stream->output_position;
+}
+
+// Copy stored block - static function
+static void inflate_stored(inflate_stream_t* stream) {
+    // Stored block starts at byte boundary
+    take(stream, stream->bit_count % 8);
+
+    size_t length = take(stream, 16);
+    size_t complement = take(stream, 16);
+    if (stream->error != 0)
+        return;
+
+    if (length != (~complement & 0xffff)) {
+        // Length doesn't match its complement
+        stream->error = EILSEQ;
+        return;
+    }
+
+    while (length > 0 && stream->bit_count >= 8) {
+        // Bytes already taken from input
+        stream->output[stream->output_position++] = (ubyte_t)take(stream, 8);
+        ++stream->total;
+        --length;
+    }
+
+    while (length > 0) {
+        if (!refill(stream)) {
+            // Compressed data ends in the middle of a block
+            if (stream->error == 0)
+                stream->error = EILSEQ;
+            return;
+        }
+
+        // Copy as much as both buffers allow
+        size_t count = stream->input_count - stream->input_position;
+        size_t room = INFLATE_WINDOW + INFLATE_OUTPUT_SIZE - stream->output_position;
+        if (count > room)
+            count = room;
+        if (count > length)
+            count = length;
+
+        memcpy(stream->output + stream->output_position, stream->input + stream->input_position, count);
+        stream->output_position += count;
+        stream->input_position += count;
+        stream->total += count;
+        length -= count;
+
+        if (stream->output_position >= INFLATE_WINDOW + INFLATE_OUTPUT_SIZE) {
+            // Output buffer is full
+            hand_over(stream);
+            if (stream->stopped)
+                return;
+        }
+    }
+}
+
+// Decode literals and back-references of a compressed block - static function
+static void inflate_codes(inflate_stream_t* stream, const inflate_huffman_t* literals, const inflate_huffman_t* distances) {
+    for (;;) {
+        int symbol = decode(stream, literals);
+        if (symbol < 0) {
+            // Invalid code
+            if (stream->error == 0)
+                stream->error = EILSEQ;
+            return;
+        }
+
+        if (symbol < 256) {
+            // Literal byte
+            stream->output[stream->output_position++] = (ubyte_t)symbol;
+            ++stream->total;
+        }
+        else if (symbol == 256) {
+            return;     // End of block
+        }
+        else {
+            // Back-reference of given length and distance
+            symbol -= 257;
+            if (symbol >= 29) {
+                stream->error = EILSEQ;
+                return;
+            }
+            size_t length = length_base[symbol] + take(stream, length_extra[symbol]);
+
+            int code = decode(stream, distances);
+            if (code < 0 || code >= 30) {
+                if (stream->error == 0)
+                    stream->error = EILSEQ;
+                return;
+            }
+            size_t distance = distance_base[code] + take(stream, distance_extra[code]);
+
+            if (stream->error != 0)
+                return;     // Compressed data ends
+
+            if (distance > stream->total) {
+                // Back-reference before the beginning of output
+                stream->error = EILSEQ;
+                return;
+            }
+
+            // Copy byte by byte, source may overlap copied bytes
+            ubyte_t* to = stream->output + stream->output_position;
+            const ubyte_t* from = to - distance;
+            for (size_t i = 0; i < length; ++i)
+                to[i] = from[i];
+
+            stream->output_position += length;
+            stream->total += length;
+        }
+
+        if (stream->output_position >= INFLATE_WINDOW + INFLATE_OUTPUT_SIZE) {
+            // Output buffer is full
+            hand_over(stream);
+            if (stream->stopped)
+                return;
+        }
+    }
+}
+
+// Decode block with fixed codes - static function
+static void inflate_fixed(inflate_stream_t* stream) {
+    ubyte_t lengths[INFLATE_MAX_LITLEN];
+    inflate_huffman_t literals, distances;
+
+    // Code lengths given by the format
+    memset(lengths, 8, 144);
+    memset(lengths + 144, 9, 112);
+    memset(lengths + 256, 7, 24);
+    memset(lengths + 280, 8, 8);
+    build(&literals, lengths, INFLATE_MAX_LITLEN);
+
+    memset(lengths, 5, 30);
+    build(&distances, lengths, 30);
+
+    inflate_codes(stream, &literals, &distances);
+}
+
+// Decode block with codes described in its header - static function
+static void inflate_dynamic(inflate_stream_t* stream) {
+    ubyte_t lengths[INFLATE_MAX_LITLEN + INFLATE_MAX_DIST];
+    inflate_huffman_t literals, distances;
+
+    size_t literal_count = take(stream, 5) + 257;
+    size_t distance_count = take(stream, 5) + 1;
+    size_t length_count = take(stream, 4) + 4;
+    if (stream->error != 0)
+        return;
+
+    if (literal_count > 286 || distance_count > 30) {
+        // More codes than the format has
+        stream->error = EILSEQ;
+        return;
+    }
+
+    // Code lengths are compressed with a code of their own
+    memset(lengths, 0, 19);
+    for (size_t i = 0; i < length_count; ++i)
+        lengths[length_order[i]] = (ubyte_t)take(stream, 3);
+
+    if (stream->error != 0 || !build(&literals, lengths, 19)) {
+        if (stream->error == 0)
+            stream->error = EILSEQ;
+        return;
+    }
+
+    size_t index = 0;
+    while (index < literal_count + distance_count) {
+        int symbol = decode(stream, &literals);
+        if (symbol < 0) {
+            if (stream->error == 0)
+                stream->error = EILSEQ;
+            return;
+        }
+
+        if (symbol < 16) {
+            // Code length itself
+            lengths[index++] = (ubyte_t)symbol;
+            continue;
+        }
+
+        // Repeated code length (previous one or zero)
+        ubyte_t repeated = 0;
+        size_t repeat;
+        if (symbol == 16) {
+            if (index == 0) {
+                // Nothing to repeat
+                stream->error = EILSEQ;
+                return;
+            }
+            repeated = lengths[index - 1];
+            repeat = 3 + take(stream, 2);
+        }
+        else if (symbol == 17) {
+            repeat = 3 + take(stream, 3);
+        }
+        else {
+            repeat = 11 + take(stream, 7);
+        }
+
+        if (stream->error != 0 || index + repeat > literal_count + distance_count) {
+            if (stream->error == 0)
+                stream->error = EILSEQ;
+            return;
+        }
+
+        while (repeat-- > 0)
+            lengths[index++] = repeated;
+    }
+
+    if (lengths[256] == 0 || !build(&literals, lengths, literal_count) || !build(&distances, lengths + literal_count, distance_count)) {
+        // Block can't end or codes are oversubscribed
+        stream->error = EILSEQ;
+        return;
+    }
+
+    inflate_codes(stream, &literals, &distances);
+}
+
+// Decompress raw deflate data at current position of file, handing output over in pieces
+int inflate_file(
+    FILE* file,
+    uqword_t compressed,
+    inflate_sink_t sink,
+    void* context
+) {
+    inflate_stream_t stream;
+    memset(&stream, 0, sizeof(stream));
+
+    stream.file = file;
+    stream.left = compressed;
+    stream.sink = sink;
+    stream.context = context;
+    stream.input = malloc(INFLATE_INPUT_SIZE);
+    stream.output = malloc(INFLATE_WINDOW + INFLATE_OUTPUT_SIZE + INFLATE_MAX_MATCH);
+
+    if (!stream.input || !stream.output) {
+        // Not enough memory for buffers
+        free(stream.input);
+        free(stream.output);
+
+        return ENOMEM;
+    }
+
+    bool last = false;
+    while (!last && stream.error == 0 && !stream.stopped) {
+        // Block header
+        last = take(&stream, 1) != 0;
+        unsigned int type = take(&stream, 2);
+        if (stream.error != 0)
+            break;
+
+        if (type == INFLATE_STORED)
+            inflate_stored(&stream);
+        else if (type == INFLATE_FIXED)
+            inflate_fixed(&stream);
+        else if (type == INFLATE_DYNAMIC)
+            inflate_dynamic(&stream);
+        else
+            stream.error = EILSEQ;      // Reserved block type
+    }
+
+    if (stream.error == 0)
+        // Rest of output
+        hand_over(&stream);
+
+    free(stream.input);
+    free(stream.output);
+
+    return stream.error;
+}
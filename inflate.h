@@ -0,0 +1,80 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: inflate.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for data types
+#ifndef __INFLATE_H__
+#define __INFLATE_H__
+
+// Define constants
+#define INFLATE_WINDOW                  32768       // Farthest distance of a back-reference
+#define INFLATE_OUTPUT_SIZE             65536       // Decompressed bytes handed over at once
+#define INFLATE_INPUT_SIZE              65536       // Compressed bytes read at once
+#define INFLATE_MAX_MATCH               258         // Longest back-reference
+#define INFLATE_MAX_BITS                15          // Longest code
+#define INFLATE_FAST_BITS               9           // Codes up to this length are decoded by a single lookup
+#define INFLATE_MAX_LITLEN              288         // Literal and length codes
+#define INFLATE_MAX_DIST                32          // Distance codes
+#define INFLATE_NO_SYMBOL               -1          // Code isn't valid
+
+// Block types
+#define INFLATE_STORED                  0
+#define INFLATE_FIXED                   1
+#define INFLATE_DYNAMIC                 2
+
+// Receiver of decompressed data, returns false once it doesn't want any more
+typedef bool (*inflate_sink_t)(
+    void* context,
+    const ubyte_t* data,
+    size_t count
+);
+
+// Canonical Huffman code
+typedef struct inflate_huffman {
+    uword_t count[INFLATE_MAX_BITS + 1];    // Number of codes of each length
+    uword_t symbol[INFLATE_MAX_LITLEN];     // Symbols ordered by their codes
+    uword_t fast[1 << INFLATE_FAST_BITS];   // Symbol and code length (above 9 bits) of short codes by next input bits (0 if longer)
+} inflate_huffman_t;
+
+// Decompression state
+typedef struct inflate_stream {
+    FILE* file;                         // Compressed input
+    uqword_t left;                      // Compressed bytes not read yet
+    ubyte_t* input;                     // Input buffer
+    size_t input_position;              // Next byte of input buffer
+    size_t input_count;                 // Bytes in input buffer
+    uqword_t bits;                      // Bits taken from input, lowest first
+    size_t bit_count;                   // Number of those bits
+    ubyte_t* output;                    // Window of previous output followed by new output
+    size_t output_position;             // End of output
+    size_t handed;                      // End of output already handed to sink
+    uqword_t total;                     // Decompressed bytes so far
+    inflate_sink_t sink;                // Receiver of decompressed data
+    void* context;                      // Context of receiver
+    bool stopped;                       // Receiver doesn't want any more
+    int error;                          // First error (0 if there is none)
+} inflate_stream_t;
+
+// Declare functions
+int inflate_file(
+    FILE* file,
+    uqword_t compressed,
+    inflate_sink_t sink,
+    void* context
+);      // Decompress raw deflate data at current position of file, handing output over in pieces
+
+#endif
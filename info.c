@@ -9,7 +9,7 @@
  * File: info.c
  *
  *-------------------------------------------------
- * Made by Marek Polek (Polda18)
+ * Made by Marek Poláček (Polda18)
  **************************************************/
 
 // Global libraries
@@ -38,7 +38,7 @@ void print_help(void) {
     fprintf(stdout, "This tool displays binary data in human readable format\n");
     fprintf(stdout, "in console window via standard output pipe.\n\n");
 
-    fprintf(stdout, "Usage: hexdump [-h] [-bcCdox] [-v] [-n <length>] [-s <offset>] <path\\to\\filename.ext>\n");
+    fprintf(stdout, "Usage: hexdump [-h] [-bBcCdox[u] | -t <type>] [-v] [-g] [-i] [-f | -V | -M] [-p | -P] [--explain] [-a <block> [-j <workers>]] [-e <length>[:utf16]] [-m <window>] [-y <pattern>[:<name>]]... [-A <member>] [-k <checksum>[:<block>]] [-O <output>[:<encoding>]] [-n <length>] [-s [-]<offset>]... [-S <stride>[:<sample>]] [-w <width>] [-D <directory> | -W <file> | -R <dumpfile> | -K <file>[:resume]] <path\\to\\filename.ext>...\n");
     fprintf(stdout, "  You can also use standard output redirection \'>\' to save dump into file\n");
     fprintf(stdout, "  or use pipe \'|\' to redirect standard output to another cmd tool.\n\n");
 
@@ -50,6 +50,11 @@ void print_help(void) {
     fprintf(stdout, "         followed by sixteen space-separated, three column, zero-filled, bytes\n");
     fprintf(stdout, "         of input file data per line.\n\n");
 
+    fprintf(stdout, "  -B     One-byte binary display.  Displays the input file offset in hexadecimal,\n");
+    fprintf(stdout, "         followed by sixteen space-separated, eight column bytes of input file data\n");
+    fprintf(stdout, "         per line, most significant bit first.  Use -w 8 to fit a line into\n");
+    fprintf(stdout, "         80 columns.\n\n");
+
     fprintf(stdout, "  -c     One-byte character display.  Displays the input file offset in hexa-\n");
     fprintf(stdout, "         decimal, followed by sixteen space-separated, three column, space-\n");
     fprintf(stdout, "         filled, characters of input file data per line.\n\n");
@@ -58,6 +63,14 @@ void print_help(void) {
     fprintf(stdout, "         decimal, followed by sixteen space-separated, two column, hexadecimal bytes,\n");
     fprintf(stdout, "         followed by the same sixteen bytes in %%_p format enlosed in \'|\' characters.\n\n");
 
+    fprintf(stdout, "  -cu, -Cu\n");
+    fprintf(stdout, "         UTF-8 character and canonical display.  Same as -c and -C, but valid UTF-8\n");
+    fprintf(stdout, "         sequences are displayed as the decoded character in the column of their\n");
+    fprintf(stdout, "         first byte, followed by a middle dot in the column of each continuation\n");
+    fprintf(stdout, "         byte.  Sequences split between two lines and invalid bytes are displayed\n");
+    fprintf(stdout, "         the same way as with -c and -C.  Console output code page is switched to\n");
+    fprintf(stdout, "         UTF-8 while hexdump runs.\n\n");
+
     fprintf(stdout, "  -d     Two-byte decimal display.  Displays the input file offset in hexadecimal,\n");
     fprintf(stdout, "         followed by eight space-separated, five column, zero-filled, two-byte units\n");
     fprintf(stdout, "         of input file data, in unsigned decimal, per line.\n\n");
@@ -70,17 +83,124 @@ void print_help(void) {
     fprintf(stdout, "         decimal, followed by eight, space-separated, four column, zero-filled, two-\n");
     fprintf(stdout, "         byte quantities of input file data, in hexadecimal, per line.\n\n");
 
+    fprintf(stdout, "  -t <type>\n");
+    fprintf(stdout, "         Typed display.  Displays the input file offset in hexadecimal, followed by\n");
+    fprintf(stdout, "         space-separated units of input file data per line, as given by <type>: x for\n");
+    fprintf(stdout, "         zero-filled hexadecimal, u for zero-filled unsigned decimal, d for signed\n");
+    fprintf(stdout, "         decimal or f for floating point, optionally followed by unit size 1, 2, 4 or\n");
+    fprintf(stdout, "         8 bytes (4 by default, f only takes 4 for float or 8 for double, default 8)\n");
+    fprintf(stdout, "         and le for little endian (default) or be for big endian, e.g. x4be or f4.\n");
+    fprintf(stdout, "         Floating point numbers are displayed with the fewest digits that read back\n");
+    fprintf(stdout, "         as the same number, nan and inf for special values.\n");
+    fprintf(stdout, "         An incomplete unit at the end is filled up with zero bytes.  Overrides the\n");
+    fprintf(stdout, "         other display switches.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -a <block>\n");
+    fprintf(stdout, "         Entropy analysis.  Instead of dumping the data, splits the input file data\n");
+    fprintf(stdout, "         into blocks of <block> bytes and displays the offset of each block in\n");
+    fprintf(stdout, "         hexadecimal, followed by its Shannon entropy in bits per byte, ratio of zero\n");
+    fprintf(stdout, "         bytes, ratio of text bytes and a guess of block contents (empty, fill, text,\n");
+    fprintf(stdout, "         random for compressed or encrypted data, or binary).  <block> accepts the\n");
+    fprintf(stdout, "         same formats and modifiers as <offset> and must be at least 256 bytes.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -e <length>[:utf16]\n");
+    fprintf(stdout, "         Strings.  Instead of dumping the data, displays every run of at least\n");
+    fprintf(stdout, "         <length> printable ASCII characters (0x20 to 0x7e) with the offset of its\n");
+    fprintf(stdout, "         first character, in hexadecimal.  With :utf16, runs of UTF-16LE characters\n");
+    fprintf(stdout, "         (printable byte followed by a zero byte) are displayed as well, each line\n");
+    fprintf(stdout, "         then has a for ASCII or u for UTF-16LE after the offset.  <length> is from 1\n");
+    fprintf(stdout, "         to 4096 (at least 2 with :utf16).  Input is classified 64 bytes at once.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -m <window>\n");
+    fprintf(stdout, "         Signature scan.  Instead of dumping the data, displays the offset and type\n");
+    fprintf(stdout, "         of every embedded structure found by its magic number: compressed data\n");
+    fprintf(stdout, "         (gzip, bzip2, xz, 7-zip, Zstandard, LZ4), archives (zip, RAR, tar, cpio,\n");
+    fprintf(stdout, "         cabinet), executables (ELF, PE, Mach-O, Java class), filesystems (Squashfs,\n");
+    fprintf(stdout, "         CramFS, UBI, ISO 9660, NTFS), firmware images (U-Boot, device tree),\n");
+    fprintf(stdout, "         images and documents (PNG, JPEG, GIF, PDF, SQLite) and certificates (DER,\n");
+    fprintf(stdout, "         PEM).  All patterns are matched at once in a single pass over the input\n");
+    fprintf(stdout, "         file data.  With a non-zero <window>, each hit is followed by the canonical\n");
+    fprintf(stdout, "         display of <window> bytes from its offset.  <window> accepts the same\n");
+    fprintf(stdout, "         formats and modifiers as <offset>.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -y <pattern>[:<name>]\n");
+    fprintf(stdout, "         Adds <pattern> of up to 64 bytes, written as hexadecimal digits (such as\n");
+    fprintf(stdout, "         1f8b08), to the signature scan (implies -m 0 unless -m is stated), its hits\n");
+    fprintf(stdout, "         are displayed as <name> (user pattern by default).  Can be stated\n");
+    fprintf(stdout, "         repeatedly (up to 256 patterns).\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -A <member>\n");
+    fprintf(stdout, "         Archive member.  Treats the file as a tar or zip archive and dumps member\n");
+    fprintf(stdout, "         <member> (or all members with *, each preceded by its name) instead of the\n");
+    fprintf(stdout, "         whole file.  Offsets are counted from the member beginning, -s and -n\n");
+    fprintf(stdout, "         select a range inside each member.  Tar headers and the zip central\n");
+    fprintf(stdout, "         directory are indexed without reading member data, stored members are\n");
+    fprintf(stdout, "         dumped right from the archive and deflated zip members as they are\n");
+    fprintf(stdout, "         decompressed.  Encrypted members and other compression methods are\n");
+    fprintf(stdout, "         reported and skipped.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -j <workers>\n");
+    fprintf(stdout, "         Number of worker threads used by the analysis, the C include, the batch\n");
+    fprintf(stdout, "         mode and the positional write mode, 0 means one per processor.  By default\n");
+    fprintf(stdout, "         ranges of 64 MiB and more and batches use one per processor (at most 4 on\n");
+    fprintf(stdout, "         network storage), smaller ranges run on a single thread.  See --explain.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -O <output>[:<encoding>]\n");
+    fprintf(stdout, "         Structured output.  Writes one record per line of input file data instead\n");
+    fprintf(stdout, "         of the display.  <output> is json (one JSON object per line with integer\n");
+    fprintf(stdout, "         \"offset\" and \"data\" members), csv (offset,data rows after a header line) or\n");
+    fprintf(stdout, "         bin (binary records of 8-byte offset, 4-byte length and raw data, all\n");
+    fprintf(stdout, "         numbers little endian).  <encoding> of json and csv data is hex (default)\n");
+    fprintf(stdout, "         or base64.  With -k, every record carries its own checksum (a member or\n");
+    fprintf(stdout, "         column named after the algorithm, 8 more bytes in binary records).\n");
+    fprintf(stdout, "         Records are never squeezed and there is no ending offset.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -k <checksum>[:<block>]\n");
+    fprintf(stdout, "         Checksum display.  Appends the checksum of each line of input file data to\n");
+    fprintf(stdout, "         the line, in hexadecimal, and displays the checksum of the whole dumped range\n");
+    fprintf(stdout, "         after the final offset.  <checksum> is either crc32c or xxh64.  With <block>,\n");
+    fprintf(stdout, "         the checksum of every <block> bytes is displayed on a separate line with the\n");
+    fprintf(stdout, "         range it covers instead of the per-line checksums.  <block> accepts the same\n");
+    fprintf(stdout, "         formats and modifiers as <offset>.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -w <width>\n");
+    fprintf(stdout, "         Display <width> bytes of input file data per line instead of sixteen, from 1\n");
+    fprintf(stdout, "         to 256 (must be even for two-byte displays).  Repeating lines are compared at\n");
+    fprintf(stdout, "         the same width.  Widths of 8, 16, 32 and 64 bytes are the fastest.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
     fprintf(stdout, "  -n <length>\n");
     fprintf(stdout, "         Interpret only <length> bytes of input file data.\n");
     fprintf(stdout, "         Should be stated as standalone switch.\n\n");
     
-    fprintf(stdout, "  -s <offset>\n");
+    fprintf(stdout, "  -s [-]<offset>\n");
     fprintf(stdout, "         Skip <offset> bytes from the beginning of the input file.  By default,\n");
     fprintf(stdout, "         <offset> is interpreted as an unsigned decimal number. With a leading \'0x\'\n");
     fprintf(stdout, "         or \'0X\', <offset> is interpreted as a hexadecimal number, otherwise\n");
     fprintf(stdout, "         with a leading \'0\', <offset> is interpreted as an octal number. Appending\n");
     fprintf(stdout, "         the character \'b\', \'k\', or \'m\' to <offset> causes it to be interpreted\n");
     fprintf(stdout, "         as a multiple of 512, 1024, or 1048576, respectively.\n");
+    fprintf(stdout, "         With a leading \'-\', <offset> is counted back from the end of\n");
+    fprintf(stdout, "         the input file.  -s and -n can be stated repeatedly (up to 64 ranges), each\n");
+    fprintf(stdout, "         <offset> with its <length> makes a range.  Ranges are dumped in file order,\n");
+    fprintf(stdout, "         each with its own offsets, and overlapping ranges are merged into one.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -S <stride>[:<sample>]\n");
+    fprintf(stdout, "         Sampling.  Displays only the first <sample> bytes of every <stride> bytes\n");
+    fprintf(stdout, "         of the input file (or of the range given by -s and -n) with their true\n");
+    fprintf(stdout, "         offsets, by default a single line.  Data between the samples are never\n");
+    fprintf(stdout, "         read, a line with -- marks each skipped part.  <stride> and <sample> use\n");
+    fprintf(stdout, "         the same formats and modifiers as <offset>.\n");
     fprintf(stdout, "         Should be stated as standalone switch.\n\n");
 
     fprintf(stdout, "  -v     Causes hexdump to display all input file data.  Without the -v switch,\n");
@@ -89,10 +209,117 @@ void print_help(void) {
     fprintf(stdout, "         are replaced with a line comprised of a single asterisk.\n");
     fprintf(stdout, "         Should be stated as standalone switch.\n\n");
 
+    fprintf(stdout, "  -g     Back-references.  Every full line identical to a line displayed anywhere\n");
+    fprintf(stdout, "         earlier is replaced with a line comprised of its offset, = same as and the\n");
+    fprintf(stdout, "         offset of the earlier line.  Consecutive lines copying consecutive earlier\n");
+    fprintf(stdout, "         lines make a single back-reference with their number of lines.  Lines are\n");
+    fprintf(stdout, "         matched by their 64-bit hash, the last 262144 distinct lines are\n");
+    fprintf(stdout, "         remembered.  The share of replaced lines is displayed on standard error\n");
+    fprintf(stdout, "         at the end of each range.  Display only, not with -W or -R.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -i     C include.  Displays the input file (or the range given by -s and -n) as\n");
+    fprintf(stdout, "         a C array declaration followed by its length, the same as xxd -i, ready to\n");
+    fprintf(stdout, "         be embedded into C or C++ source.  The array is named after the input\n");
+    fprintf(stdout, "         file, characters other than letters and digits become underscores.  Lines\n");
+    fprintf(stdout, "         hold 12 bytes unless -w is stated.  Lines of large inputs are rendered by\n");
+    fprintf(stdout, "         several workers (-j), the same as analysis.  Not with -f, -S, -W, -R or -K.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -D <directory>\n");
+    fprintf(stdout, "         Batch mode.  Dumps every input file into its own output file in <directory>\n");
+    fprintf(stdout, "         (created if missing), named after the input file with .txt added (.json,\n");
+    fprintf(stdout, "         .csv or .bin with -O).  Any number of input files can be stated after the\n");
+    fprintf(stdout, "         last switch, an argument starting with @ names a file listing input paths,\n");
+    fprintf(stdout, "         one per line.  Files are dumped in parallel by as many workers as given by\n");
+    fprintf(stdout, "         -j.  A file that cannot be dumped is reported and the rest of the batch\n");
+    fprintf(stdout, "         goes on; the return code is the error of the first failed file.  Input\n");
+    fprintf(stdout, "         files of the same name from different directories get their number in the\n");
+    fprintf(stdout, "         batch added (readme.txt.3.txt), so no output file overwrites another.\n");
+    fprintf(stdout, "         Plain dumps of a single range only, not with -a, -e, -m, -A, -i, -f, -V,\n");
+    fprintf(stdout, "         -S, -M, -p or -P.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -W <file>\n");
+    fprintf(stdout, "         Positional write mode.  Dumps the input file into <file> by as many workers\n");
+    fprintf(stdout, "         as given by -j.  Every line of the display has the same length, so the\n");
+    fprintf(stdout, "         output file gets its final size first and each worker writes its part of\n");
+    fprintf(stdout, "         the dump right where it belongs, without waiting for the others.  Lines\n");
+    fprintf(stdout, "         end with CR LF like redirected console output, -v is implied.  Works with\n");
+    fprintf(stdout, "         any display except UTF-8 ones and with -O bin, for a single range and\n");
+    fprintf(stdout, "         without -k.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -R <dumpfile>\n");
+    fprintf(stdout, "         Incremental dump.  Dumps the input file into <dumpfile> and keeps a hash of\n");
+    fprintf(stdout, "         every 1 MiB block of the input file in <dumpfile>.idx.  Next time the same\n");
+    fprintf(stdout, "         file is dumped into the same <dumpfile> with the same options, blocks that\n");
+    fprintf(stdout, "         haven\'t changed are copied from the previous dump instead of being rendered\n");
+    fprintf(stdout, "         again.  Lines end with CR LF like redirected console output, -v is implied.\n");
+    fprintf(stdout, "         Works for a single range and without -k.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -K <file>[:resume]\n");
+    fprintf(stdout, "         Checkpointed dump.  Writes the dump into <file> and every 256 MiB of input\n");
+    fprintf(stdout, "         data records the input position, the output size and the squeeze and\n");
+    fprintf(stdout, "         checksum state into <file>.ckpt, which is removed once the dump is\n");
+    fprintf(stdout, "         complete.  With the :resume modifier, an interrupted dump of the same file,\n");
+    fprintf(stdout, "         range, display, -v and -k options (and unchanged input data) cuts <file>\n");
+    fprintf(stdout, "         back to its last checkpoint and continues from there, byte for byte the\n");
+    fprintf(stdout, "         same as an uninterrupted dump.\n");
+    fprintf(stdout, "         Works for a single range and without -g.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -M     Process memory mode.  The last argument is a process identifier instead of\n");
+    fprintf(stdout, "         a file name.  Dumps readable memory of the running process without writing\n");
+    fprintf(stdout, "         it out first, offsets are virtual addresses of the process.  <offset> and\n");
+    fprintf(stdout, "         <length> select addresses to be dumped (several ranges can be stated),\n");
+    fprintf(stdout, "         whole user address space by default.  Memory that is not mapped or cannot\n");
+    fprintf(stdout, "         be read is marked with a line of two dashes.  Reads memory of processes of\n");
+    fprintf(stdout, "         other users only when run as administrator.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  --explain\n");
+    fprintf(stdout, "         Prints the reading plan to standard error output before the dump: where\n");
+    fprintf(stdout, "         the input lies (local or network storage, raw device), chunk size and\n");
+    fprintf(stdout, "         access hint used for reading and number of workers, each with the reason\n");
+    fprintf(stdout, "         it was chosen.  Chunks are 64 KiB for ranges below 16 MiB and for\n");
+    fprintf(stdout, "         scattered reads (-S, several ranges), 1 MiB for larger ranges and 4 MiB for\n");
+    fprintf(stdout, "         larger ranges on network storage.\n\n");
+
+    fprintf(stdout, "  -f     Follow mode.  After the input file data are dumped, waits for data to be\n");
+    fprintf(stdout, "         appended to the input file and dumps them as they come, like tail -f.  Starts\n");
+    fprintf(stdout, "         at the current end of the input file unless <offset> is stated, with <length>\n");
+    fprintf(stdout, "         stops after <length> bytes.  Incomplete last line is displayed once it\'s\n");
+    fprintf(stdout, "         complete or when following is stopped with Ctrl+C.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -V     Interactive viewer.  Browses the input file in the console window instead\n");
+    fprintf(stdout, "         of dumping it, only the lines visible on screen are displayed, so even huge\n");
+    fprintf(stdout, "         files open instantly.  Uses canonical display unless another display switch\n");
+    fprintf(stdout, "         is stated, starts at <offset> if stated.  Keys: arrows, Page Up, Page Down,\n");
+    fprintf(stdout, "         Home and End (or j, k, b and space) move around, g jumps to an offset,\n");
+    fprintf(stdout, "         / searches for text, n finds next match and q quits.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -p     Reports progress of the dump on standard error output (percentage of the\n");
+    fprintf(stdout, "         dumped range, current throughput and estimated time left).  Report is\n");
+    fprintf(stdout, "         only shown if standard error output is a console window, redirect standard\n");
+    fprintf(stdout, "         output to a file to keep the dump and the report apart.\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
+    fprintf(stdout, "  -P     Same as -p, but the report is written even if standard error output is\n");
+    fprintf(stdout, "         redirected (a new line every ten seconds).\n");
+    fprintf(stdout, "         Should be stated as standalone switch.\n\n");
+
     fprintf(stdout, "A tip for Windows users: If you need to hexdump a file with spaces in its name or path,\n");
     fprintf(stdout, "make sure the path of the file including the file name is surrounded with quotes. Command\n");
     fprintf(stdout, "line automatically inteprets sequence of characters between quotes as a single argument.\n");
 
+    fprintf(stdout, "\nRaw disks and volumes can be dumped directly as \\\\.\\PhysicalDrive0 or \\\\.\\C: (run as\n");
+    fprintf(stdout, "administrator).  Offsets and lengths work the same as with files, the device is read\n");
+    fprintf(stdout, "in whole sectors.  -V, -f and -W work with regular files only.\n");
+
     // TODO: Help page of hexdump
 }
 
@@ -129,4 +356,12 @@ void print_error_memory(char* msg) {
     // Memory error occured
     fprintf(stderr, "ERROR! %s\n", msg);
     fprintf(stderr, "Consider freeing up your memory space!\n");
-}
\ No newline at end of file
+}
+
+// Error of a single file print (batch keeps going, so there is no header)
+void print_path_error(const char* path, int error) {
+    char system_msg[MAX_MSG];
+
+    strerror_s(system_msg, MAX_MSG, error);
+    fprintf(stderr, "ERROR! %s: %s\n", path, system_msg);
+}
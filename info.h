@@ -9,7 +9,7 @@
  * File: info.h
  *
  *-------------------------------------------------
- * Made by Marek Polek (Polda18)
+ * Made by Marek Poláček (Polda18)
  **************************************************/
 
 #pragma once
@@ -25,5 +25,6 @@ void print_help(void);
 void print_error(char* msg);
 void print_file_error(char* msg);
 void print_error_memory(char* msg);
+void print_path_error(const char* path, int error);
 
 #endif
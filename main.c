@@ -9,7 +9,7 @@
  * File: main.c
  *
  *-------------------------------------------------
- * Made by Marek Polek (Polda18)
+ * Made by Marek Poláček (Polda18)
  **************************************************/
 
 // Global definitions
@@ -19,18 +19,199 @@
 #include <string.h>
 #include <errno.h>
 #include <math.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <windows.h>
 
 // Local definitions
 #include "switches.h"
 #include "dumps.h"
 #include "info.h"
+#include "progress.h"
+#include "analysis.h"
+#include "workers.h"
+#include "checksum.h"
+#include "follow.h"
+#include "viewer.h"
+#include "ranges.h"
+#include "records.h"
+#include "batch.h"
+#include "writer.h"
+#include "device.h"
+#include "reuse.h"
+#include "procmem.h"
+#include "plan.h"
+#include "extract.h"
+#include "scan.h"
+#include "archive.h"
+#include "checkpoint.h"
+#include "include.h"
+
+// Parse formatted size value - static function
+static bool parse_size(const char* string, size_t* value) {
+    // Number is decimal by default, hexadecimal with a leading '0x' or '0X'
+    // and octal with a leading '0', optionally followed by a modifier
+    int base = 10;
+    char* end;
+
+    if (string[0] == '0' && (string[1] == 'x' || string[1] == 'X')) {
+        // Number starts with a preceding 0x -> hexadecimal
+        base = 16;
+        string += 2;
+    }
+    else if (string[0] == '0' && string[1] != 0) {
+        // Number starts only with a preceding 0 -> octal
+        base = 8;
+        ++string;
+    }
+
+    if (!isxdigit((unsigned char)string[0]))
+        // No digits at all (signs and white spaces aren't accepted eighter)
+        return false;
+
+    errno = 0;
+    unsigned long long number = strtoull(string, &end, base);
+
+    if (end == string || errno == ERANGE)
+        // Cannot be interpreted
+        return false;
+
+    switch (*end) {
+        // Read the modifier character
+    case 'b':
+        // .5k modifier
+        number *= 512;
+        ++end;
+        break;
+    case 'k':
+        // 1k modifier
+        number *= 1024;
+        ++end;
+        break;
+    case 'm':
+        // 1M modifier
+        number *= 1048576;
+        ++end;
+        break;
+    }
+
+    if (*end != 0)
+        // Trailing characters after the number and modifier
+        return false;
+
+    *value = (size_t)number;
+    return true;
+}
+
+// Parse checksum specification - static function
+static bool parse_checksum(const char* string, int* algorithm, size_t* block) {
+    // Specification is an algorithm name, optionally followed by a colon and a block size
+    char name[16];
+    const char* colon = strchr(string, ':');
+    size_t namelen = (colon) ? (size_t)(colon - string) : strlen(string);
+
+    if (namelen >= sizeof(name))
+        // Too long to be any of known names
+        return false;
+
+    memcpy(name, string, namelen);
+    name[namelen] = 0;
+
+    *algorithm = checksum_parse(name);
+    *block = 0;
+
+    if (*algorithm == CHECKSUM_NONE)
+        // Unknown algorithm
+        return false;
+
+    // Block size (if given) must be a non-zero formatted number
+    return !colon || (parse_size(colon + 1, block) && *block > 0);
+}
+
+// Parse sampling specification - static function
+static bool parse_sample(const char* string, size_t* stride, size_t* sample) {
+    // Specification is a stride, optionally followed by a colon and a sample length
+    char number[32];
+    const char* colon = strchr(string, ':');
+    size_t numlen = (colon) ? (size_t)(colon - string) : strlen(string);
+
+    if (numlen >= sizeof(number))
+        // Too long to be a number
+        return false;
+
+    memcpy(number, string, numlen);
+    number[numlen] = 0;
+    *sample = 0;
+
+    if (!parse_size(number, stride) || *stride == 0)
+        // Stride must be a non-zero formatted number
+        return false;
+
+    // Sample length (if given) must be a non-zero formatted number
+    return !colon || (parse_size(colon + 1, sample) && *sample > 0);
+}
+
+// Parse strings specification - static function
+static bool parse_strings(const char* string, size_t* minimum, bool* utf16) {
+    // Specification is a minimal length, optionally followed by a colon and utf16
+    char number[32];
+    const char* colon = strchr(string, ':');
+    size_t numlen = (colon) ? (size_t)(colon - string) : strlen(string);
+
+    if (numlen >= sizeof(number))
+        // Too long to be a number
+        return false;
+
+    memcpy(number, string, numlen);
+    number[numlen] = 0;
+    *utf16 = colon && strcmp(colon + 1, EXTRACT_ENCODING_UTF16) == 0;
+
+    if (colon && !*utf16)
+        // Unknown modifier
+        return false;
+
+    // Single characters would split UTF-16LE strings into ASCII ones
+    return parse_size(number, minimum) && *minimum >= ((*utf16) ? 2 : 1) && *minimum <= EXTRACT_MAX_LENGTH;
+}
 
 // Main program
 int main(int argc, char** argv) {
     int retcode = 0;                    // Initializing return code
     FILE* file;                         // Declare file descriptor
-    unsigned int switches = 0;          // Switches flag register
+    unsigned long long switches = 0;    // Switches flag register
     bool verbose = false;               // Checks a verbose flag
+    progress_t progress;                // Progress reporter
+    size_t block_size = 0;              // Analysis block size
+    unsigned int workers = 1;           // Number of worker threads (0 means one per processor)
+    bool workers_stated = false;        // Number of workers was stated (otherwise it's planned)
+    plan_t plan;                        // Reading strategy
+    int checksum = CHECKSUM_NONE;       // Checksum algorithm
+    size_t checksum_block = 0;          // Checksum block size (0 means every line)
+    unsigned int width = DUMP_DEFAULT_WIDTH;    // Bytes per line
+    bool width_stated = false;          // Width was stated on command line (C include has a width of its own)
+    dump_format_t typed;                // Typed display format
+    bool typed_set = false;             // Typed display was stated
+    size_t stride = 0;                  // Sampling stride
+    size_t sample = 0;                  // Sample length (0 means one line)
+    int output = OUTPUT_TEXT;           // Output kind
+    int encoding = ENCODING_HEX;        // Data encoding of JSON and CSV records
+    const char* directory = NULL;       // Output directory of batch
+    const char* target = NULL;          // Output file written by workers
+    const char* dumpfile = NULL;        // Dump file of incremental dump
+    size_t strings_minimum = 0;         // Shortest string displayed by strings mode
+    bool strings_utf16 = false;         // Strings mode looks for UTF-16LE strings as well
+    size_t scan_window = 0;             // Bytes displayed from each signature found (0 means none)
+    scan_pattern_t scan_user[SCAN_MAX_USER];    // User patterns of signature scan
+    size_t scan_count = 0;              // Number of user patterns
+    const char* member = NULL;          // Dumped archive member (ARCHIVE_ALL for all of them)
+    char* checkpointed = NULL;          // Output file of checkpointed dump
+    bool resume = false;                // Checkpointed dump continues from its last checkpoint
+    int paths_begin = 0;                // First path argument (several of them in batch mode)
+    bool path_between = false;          // A path is followed by other arguments
+    bool switch_after_path = false;     // A switch follows a path argument
+    bool offset_stated = false;         // Offset was stated on command line
+    range_list_t ranges;                // Offsets and lengths stated on command line
+    ranges.count = 0;                   // No range means whole file
     size_t length, offset;              // Offset and length of file to read
     length = offset = 0;                // Init length and offset to be zero (default value)
                                         // Zero in length means until end of file,
@@ -38,13 +219,18 @@ int main(int argc, char** argv) {
 
     for (int i = 1; i < argc; ++i) {
         // Iterate through command line arguments
-        bool offset_set, length_set, help_set, verbose_set;
-        offset_set = length_set = help_set = verbose_set = false;
-        // Check variables for if offset length, help or verbose was set
+        bool offset_set, length_set, help_set, verbose_set, block_set, workers_set, checksum_set, width_set, type_set, sample_set, output_set, batch_set, write_set, reuse_set, strings_set, window_set, pattern_set, member_set, checkpoint_set;
+        offset_set = length_set = help_set = verbose_set = block_set = workers_set = checksum_set = width_set = type_set = sample_set = output_set = batch_set = write_set = reuse_set = strings_set = window_set = pattern_set = member_set = checkpoint_set = false;
+        // Check variables for if offset length, help, verbose, analysis block, workers, checksum, width, type, sampling, output, batch, write, incremental dump, strings, signature window, pattern, archive member or checkpointed output was set
+
+        // Long explain switch isn't made of switch characters
+        bool explain_set = strcmp(argv[i], PLAN_EXPLAIN_SWITCH) == 0;
+        if (explain_set)
+            switches |= SW_EXPLAIN;
 
         // Set up character index
         int j = 0;
-        while (argv[i][j] != 0) {       // Null-byte terminated string
+        while (!explain_set && argv[i][j] != 0) {       // Null-byte terminated string
             // Loop through characters in current argument
             if (j == 0 && argv[i][j] != '-')
                 break;      // Exit the while loop if the first character isn't dash
@@ -74,6 +260,15 @@ int main(int argc, char** argv) {
                         // Proceed
                         switches |= SW_DUMP_BYTE_OCTAL;
                     break;
+                case 'B':
+                    // Binary byte switch stated
+                    if (j > 1 && (offset_set || length_set || help_set))
+                        // Offset, lenght or help was already set -> invalid
+                        switches |= SW_INVALID;
+                    else
+                        // Proceed
+                        switches |= SW_DUMP_BYTE_BINARY;
+                    break;
                 case 'c':
                     // Character byte switch stated
                     if (j > 1 && (offset_set || length_set || help_set))
@@ -92,6 +287,15 @@ int main(int argc, char** argv) {
                         // Proceed
                         switches |= SW_DUMP_CANONICAL;
                     break;
+                case 'u':
+                    // UTF-8 modifier stated
+                    if (argv[i][j - 1] != 'c' && argv[i][j - 1] != 'C')
+                        // Only modifies a preceding character display -> invalid
+                        switches |= SW_INVALID;
+                    else
+                        // Proceed
+                        switches |= SW_UTF8;
+                    break;
                 case 'd':
                     // Decimal word switch stated
                     if (j > 1 && (offset_set || length_set || help_set))
@@ -140,6 +344,185 @@ int main(int argc, char** argv) {
                         // Otherwise it's invalid
                         switches |= SW_INVALID;
                     break;
+                case 'a':
+                    // Analysis switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_ANALYSIS;
+                        block_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'j':
+                    // Workers switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        workers_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'k':
+                    // Checksum switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        checksum_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'f':
+                    // Follow switch stated
+                    if (j == 1)
+                        // Can only be single
+                        switches |= SW_FOLLOW;
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'V':
+                    // Viewer switch stated
+                    if (j == 1)
+                        // Can only be single
+                        switches |= SW_VIEWER;
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 't':
+                    // Type switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        type_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'S':
+                    // Sampling switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_SAMPLE;
+                        sample_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'e':
+                    // Strings switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_STRINGS;
+                        strings_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'm':
+                    // Signature scan switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_SCAN;
+                        window_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'y':
+                    // Signature pattern switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_SCAN;
+                        pattern_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'A':
+                    // Archive member switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_ARCHIVE;
+                        member_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'O':
+                    // Output switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_OUTPUT;
+                        output_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'D':
+                    // Batch switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_BATCH;
+                        batch_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'W':
+                    // Write switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_WRITE;
+                        write_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'R':
+                    // Incremental dump switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_REUSE;
+                        reuse_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'K':
+                    // Checkpoint switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        switches |= SW_CHECKPOINT;
+                        checkpoint_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'w':
+                    // Width switch stated
+                    if (j == 1) {
+                        // Can only be single
+                        width_set = true;
+                    }
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
                 case 'v':
                     // Verbose switch stated
                     if (j == 1) {
@@ -151,6 +534,51 @@ int main(int argc, char** argv) {
                         // Otherwise it's invalid
                         switches |= SW_INVALID;
                     break;
+                case 'g':
+                    // Back-reference switch stated
+                    if (j == 1)
+                        // Can only be single
+                        switches |= SW_DEDUP;
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'i':
+                    // C include switch stated
+                    if (j == 1)
+                        // Can only be single
+                        switches |= SW_INCLUDE;
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'M':
+                    // Process memory switch stated
+                    if (j == 1)
+                        // Can only be single
+                        switches |= SW_PROCESS;
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'p':
+                    // Progress switch stated
+                    if (j == 1)
+                        // Can only be single
+                        switches |= SW_PROGRESS;
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
+                case 'P':
+                    // Forced progress switch stated
+                    if (j == 1)
+                        // Can only be single
+                        switches |= SW_PROGRESS | SW_PROGRESS_FORCE;
+                    else
+                        // Otherwise it's invalid
+                        switches |= SW_INVALID;
+                    break;
 
                 default:
                     // Invalid switch stated
@@ -165,105 +593,213 @@ int main(int argc, char** argv) {
             // An invalid switch is flagged => cancel iteration
             break;
 
-        if (offset_set && (i == argc - 1 || argv[i + 1][0] == '-'))
-            // Offset is set and next argument is missing or starts with a dash (another switch)
+        if (offset_set && (i == argc - 1 || (argv[i + 1][0] == '-' && !isdigit((unsigned char)argv[i + 1][1]))))
+            // Offset is set and next argument is missing or starts with a dash (another switch),
+            // a dash followed by a digit is an offset from the end of file
             switches |= SW_INVALID;
         else if (offset_set) {
+            // Try to parse next argument as a formatted size value
+            bool from_end = argv[++i][0] == '-';
+            if (!parse_size(argv[i] + from_end, &offset))
+                // Cannot be interpreted
+                switches |= SW_OFFSETFORMAT;
+            else if (!ranges_add_offset(&ranges, offset, from_end))
+                // Too many ranges
+                switches |= SW_RANGECOUNT;
+            offset_stated = true;
+        }
+
+        if (length_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Length is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (length_set) {
             // Try to parse next argument as an unsigned size value
-            size_t modifier = 1;    // Set up a modifier
+            if (!sscanf_s(argv[++i], "%lu", &length))
+                // Cannot be interpreted
+                switches |= SW_LENGTHFORMAT;
+            else if (!ranges_add_length(&ranges, length))
+                // Too many ranges
+                switches |= SW_RANGECOUNT;
+        }
 
-            // Get number specification string length
-            int modlen = strlen(argv[i + 1]);
+        if (block_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Analysis block is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (block_set) {
+            // Try to parse next argument as a formatted size value
+            if (!parse_size(argv[++i], &block_size) || block_size < ANALYSIS_MIN_BLOCK)
+                // Cannot be interpreted or block is too small
+                switches |= SW_BLOCKFORMAT;
+        }
 
-            if (modlen < 1) {
-                // Empty string (unlikely to happen, but still to be sure)
-                switches |= SW_OFFSETFORMAT;
-                continue;
-            }
+        if (workers_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Workers are set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (workers_set) {
+            // Try to parse next argument as an unsigned decimal value
+            if (!sscanf_s(argv[++i], "%u", &workers))
+                // Cannot be interpreted
+                switches |= SW_WORKERSFORMAT;
+            workers_stated = true;
+        }
 
-            switch (argv[i + 1][modlen - 1]) {
-                // Read the last character
-            case 'b':
-                // .5k modifier
-                modifier *= 512;
-                break;
-            case 'k':
-                // 1k modifier
-                modifier *= 1024;
-                break;
-            case 'm':
-                // 1M modifier
-                modifier *= 1048576;
-                break;
-            }
+        if (checksum_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Checksum is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (checksum_set) {
+            // Try to parse next argument as an algorithm name with an optional block size
+            if (!parse_checksum(argv[++i], &checksum, &checksum_block))
+                // Cannot be interpreted
+                switches |= SW_CHECKSUMFORMAT;
+        }
 
-            // Set a space for an argument copy based on modifier
-            char* number_copy = malloc((modifier > 1) ? modlen - 1 : modlen);
+        if (width_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Width is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (width_set) {
+            // Try to parse next argument as an unsigned decimal value
+            if (!sscanf_s(argv[++i], "%u", &width) || width < 1 || width > DUMP_MAX_LINE_WIDTH)
+                // Cannot be interpreted or out of range
+                switches |= SW_WIDTHFORMAT;
+            width_stated = true;
+        }
 
-            // Copy bytes over
-            for (int l = 0; l < modlen; ++l) {
-                // Set up condition
-                bool modified = (modifier > 1 && l == modlen - 1);
+        if (type_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Type is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (type_set) {
+            // Try to parse next argument as a type specification
+            if (!dump_parse_type(argv[++i], &typed))
+                // Cannot be interpreted
+                switches |= SW_TYPEFORMAT;
+            typed_set = true;
+        }
 
-                // Copy over bytes of the argument (omit last byte if modifier is upgraded)
-                number_copy[l] = (modified)? 0 : argv[i + 1][l];
+        if (sample_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Sampling is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (sample_set) {
+            // Try to parse next argument as a stride with an optional sample length
+            if (!parse_sample(argv[++i], &stride, &sample))
+                // Cannot be interpreted
+                switches |= SW_SAMPLEFORMAT;
+        }
 
-                if (modified)
-                    // Modifier applied -> exit the loop
-                    break;
-            }
+        if (output_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Output is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (output_set) {
+            // Try to parse next argument as an output name with an optional encoding
+            output = record_parse(argv[++i], &encoding);
+            if (output == OUTPUT_TEXT)
+                // Cannot be interpreted
+                switches |= SW_OUTPUTFORMAT;
+        }
 
-            if (number_copy[0] == '0') {
-                // Number starts with a predecing 0 -> can be hex or octal
-                if (number_copy[1] == 'x') {
-                    // Number starts with a preceding 0x -> hexadecimal
-                    if (!sscanf_s((number_copy + 2), "%lx", &offset) && !sscanf_s((number_copy + 2), "%lX", &offset))
-                        // Cannot be interpreted
-                        switches |= SW_OFFSETFORMAT;
-                }
-                else {
-                    // Number starts only with a preceding 0 -> octal
-                    if (!sscanf_s((number_copy + 1), "%lo", &offset))
-                        // Cannot be interpreted
-                        switches |= SW_OFFSETFORMAT;
-                }
-            }
-            else {
-                // Number isn't preceeded by a format modifier -> unsigned decimal value
-                if (!sscanf_s(number_copy, "%lu", &offset))
-                    // Cannot be interpreted
-                    switches |= SW_OFFSETFORMAT;
-            }
+        if (batch_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Batch is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (batch_set)
+            // Next argument is the output directory
+            directory = argv[++i];
 
-            // Modify the offset by a modifier value
-            offset *= modifier;
+        if (write_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Write is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (write_set)
+            // Next argument is the output file
+            target = argv[++i];
 
-            // Tidy up
-            free(number_copy);
+        if (reuse_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Incremental dump is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (reuse_set)
+            // Next argument is the dump file
+            dumpfile = argv[++i];
 
-            // Increment counter
-            ++i;
+        if (checkpoint_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Checkpoint is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (checkpoint_set) {
+            // Next argument is the output file, optionally followed by the resume modifier
+            checkpointed = argv[++i];
+            if (!checkpoint_parse(checkpointed, &resume))
+                // Output file is missing
+                switches |= SW_INVALID;
         }
 
-        if (length_set && (i == argc - 1 || argv[i + 1][0] == '-'))
-            // Length is set and next argument is missing or starts with a dash (another switch)
+        if (strings_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Strings are set and next argument is missing or starts with a dash (another switch)
             switches |= SW_INVALID;
-        else if (length_set) {
-            // Try to parse next argument as an unsigned size value
-            if (!sscanf_s(argv[++i], "%lu", &length))
+        else if (strings_set) {
+            // Try to parse next argument as a minimal length with an optional encoding
+            if (!parse_strings(argv[++i], &strings_minimum, &strings_utf16))
                 // Cannot be interpreted
-                switches |= SW_LENGTHFORMAT;
+                switches |= SW_STRINGSFORMAT;
+        }
+
+        if (window_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Signature window is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (window_set) {
+            // Try to parse next argument as a formatted size value
+            if (!parse_size(argv[++i], &scan_window))
+                // Cannot be interpreted
+                switches |= SW_SCANFORMAT;
         }
 
-        if (!offset_set && !length_set && i == argc - 1 && argv[i][0] == '-')
+        if (pattern_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Signature pattern is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (pattern_set) {
+            // Try to parse next argument as hexadecimal bytes with an optional name
+            if (scan_count == SCAN_MAX_USER || !scan_parse(argv[++i], &scan_user[scan_count]))
+                // Cannot be interpreted or too many patterns
+                switches |= SW_SCANFORMAT;
+            else
+                ++scan_count;
+        }
+
+        if (member_set && (i == argc - 1 || argv[i + 1][0] == '-'))
+            // Archive member is set and next argument is missing or starts with a dash (another switch)
+            switches |= SW_INVALID;
+        else if (member_set)
+            // Next argument is the member name
+            member = argv[++i];
+
+        // Check for a switch that took the next argument as its value
+        bool value_set = offset_set || length_set || block_set || workers_set || checksum_set || width_set || type_set || sample_set || output_set || batch_set || write_set || reuse_set || strings_set || window_set || pattern_set || member_set || checkpoint_set;
+
+        if (!value_set && i == argc - 1 && argv[i][0] == '-')
             // File wasn't specified at the end of the command line
             switches |= SW_FILEUNKNOWN;
 
-        if (!offset_set && !length_set && i < argc - 1 && argv[i][0] != '-')
-            // File was specified in between arguments (not last) => invalid argument
-            switches |= SW_FILEELSEWHERE;
+        if (!value_set && argv[i][0] != '-') {
+            // Path argument, batch takes all paths after the last switch
+            if (paths_begin == 0)
+                paths_begin = i;
+            if (i < argc - 1)
+                path_between = true;
+        }
+        else if (paths_begin > 0)
+            switch_after_path = true;
     }
 
+    if (path_between && (!(switches & SW_BATCH) || switch_after_path))
+        // File was specified in between arguments (not last) => invalid argument
+        switches |= SW_FILEELSEWHERE;
+
+    // Displays of wider units need whole units on each line (two-byte for plain hex, -d, -o and -x)
+    size_t unit = (switches & (SW_DUMP_BYTE_OCTAL | SW_DUMP_BYTE_BINARY | SW_DUMP_BYTE_CHAR | SW_DUMP_CANONICAL)) ? BYTE_SIZE : WORD_SIZE;
+    if (typed_set && !(switches & SW_TYPEFORMAT))
+        unit = typed.unit;
+    if (output != OUTPUT_TEXT)
+        unit = BYTE_SIZE;       // Records hold any number of raw bytes
+    if (switches & SW_INCLUDE)
+        unit = BYTE_SIZE;       // C array holds any number of bytes per line
+    if (width % unit != 0)
+        switches |= SW_WIDTHFORMAT;
+
     // Check arguments list after iteration
     if (argc < 2)
         // No arguments were provided (iteration was skipped) => no file specified
@@ -301,6 +837,86 @@ int main(int argc, char** argv) {
         return 3;
     }
 
+    // Check if an analysis block size has been misspelled
+    if (switches & SW_BLOCKFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Analysis block must be a formatted number of at least 256 bytes");
+
+        return 6;
+    }
+
+    // Check if a number of workers has been misspelled
+    if (switches & SW_WORKERSFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Number of workers must be a decimal number");
+
+        return 7;
+    }
+
+    // Check if a checksum specification has been misspelled
+    if (switches & SW_CHECKSUMFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Checksum must be crc32c or xxh64, optionally followed by a colon and a block size");
+
+        return 8;
+    }
+
+    // Check if a line width has been misspelled
+    if (switches & SW_WIDTHFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Width must be a decimal number from 1 to 256 and a multiple of the display unit size");
+
+        return 9;
+    }
+
+    // Check if a type specification has been misspelled
+    if (switches & SW_TYPEFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Type must be x, u, d or f, optionally followed by size 1, 2, 4 or 8 (4 or 8 for f) and le or be");
+
+        return 10;
+    }
+
+    // Check if too many ranges have been stated
+    if (switches & SW_RANGECOUNT) {
+        // Print out error message and guide user to help command
+        print_error("At most 64 ranges can be dumped at once");
+
+        return 11;
+    }
+
+    // Check if a sampling specification has been misspelled
+    if (switches & SW_SAMPLEFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Sampling must be a stride, optionally followed by a colon and a sample length");
+
+        return 12;
+    }
+
+    // Check if an output specification has been misspelled
+    if (switches & SW_OUTPUTFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Output must be json or csv, optionally followed by :hex or :base64, or bin");
+
+        return 13;
+    }
+
+    // Check if a strings specification has been misspelled
+    if (switches & SW_STRINGSFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Strings must be a minimal length from 1 to 4096 (2 with utf16), optionally followed by :utf16");
+
+        return 18;
+    }
+
+    // Check if a signature window or pattern has been misspelled
+    if (switches & SW_SCANFORMAT) {
+        // Print out error message and guide user to help command
+        print_error("Signature window must be a formatted number, pattern up to 64 hexadecimal bytes, optionally followed by a colon and a name");
+
+        return 19;
+    }
+
     // Top fifth priority: check if a file path/name is ommited
     if (switches & SW_FILEUNKNOWN) {
         // Print out error message and guide user to help command
@@ -321,8 +937,146 @@ int main(int argc, char** argv) {
     if (switches & SW_VERBOSE)
         verbose = true;     // Verbose has been enabled
 
-    // Path is clear, let's try to open the file for reading in binary mode
-    file = fopen(argv[argc - 1], "rb");
+    // Path is clear, check for dump switches and pick the line format
+    const dump_format_t* format = &format_plain_hex;    // Plain hexadecimal two-byte system-endian representation
+
+    if (typed_set)
+        format = &typed;                    // Typed representation of given size and endianness
+    else if (switches & SW_DUMP_BYTE_OCTAL)
+        format = &format_byte_octal;        // Octal one-byte representation
+    else if (switches & SW_DUMP_BYTE_BINARY)
+        format = &format_byte_binary;       // Binary one-byte representation
+    else if (switches & SW_DUMP_BYTE_CHAR)
+        format = (switches & SW_UTF8) ? &format_byte_char_utf8 : &format_byte_char;     // Character one-byte ASCII (or UTF-8) representation
+    else if (switches & SW_DUMP_CANONICAL)
+        format = (switches & SW_UTF8) ? &format_canonical_utf8 : &format_canonical;     // Canonical HEX+ASCII (or UTF-8) one-byte representation
+    else if (switches & SW_DUMP_WORD_DECIMAL)
+        format = &format_word_decimal;      // Decimal aligned two-byte system-endian representation
+    else if (switches & SW_DUMP_WORD_OCTAL)
+        format = &format_word_octal;        // Octal aligned two-byte system-endian representation
+    else if (switches & SW_DUMP_WORD_HEX)
+        format = &format_word_hex;          // Hexadecimal aligned two-byte system-endian representation
+
+    // Set up dump options
+    dump_options_t options;
+    options.verbose = verbose;
+    options.checksum = checksum;
+    options.checksum_block = checksum_block;
+    options.width = width;
+    options.output = output;
+    options.encoding = encoding;
+    options.alignment = 1;
+    options.chunk_size = DUMP_CHUNK_SIZE;
+    options.dedup = (switches & SW_DEDUP) != 0;
+
+    // Check if positional writing can compute where each line goes
+    if ((switches & SW_WRITE) && ((switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_FOLLOW | SW_VIEWER | SW_SAMPLE | SW_BATCH)) || ranges.count > 1 || !write_supported(format, &options))) {
+        // Print out error message and guide user to help command
+        print_error("Output file can only be written from a single range, without checksums, back-references, UTF-8 or JSON and CSV records");
+
+        return 14;
+    }
+
+    // Check if incremental dump can render blocks independently of each other
+    if ((switches & SW_REUSE) && ((switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_FOLLOW | SW_VIEWER | SW_SAMPLE | SW_BATCH | SW_WRITE)) || ranges.count > 1 || checksum != CHECKSUM_NONE || options.dedup)) {
+        // Print out error message and guide user to help command
+        print_error("Incremental dump can only be made of a single range, without checksums or back-references");
+
+        return 15;
+    }
+
+    // Check if checkpointed dump can be continued from its recorded state
+    if ((switches & SW_CHECKPOINT) && ((switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_FOLLOW | SW_VIEWER | SW_SAMPLE | SW_BATCH | SW_WRITE | SW_REUSE)) || ranges.count > 1 || options.dedup)) {
+        // Print out error message and guide user to help command
+        print_error("Checkpointed dump can only be made of a single range, without back-references");
+
+        return 20;
+    }
+
+    // Check if batch can dump every file the same way (a single range of plain dump each)
+    if ((switches & SW_BATCH) && ((switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_FOLLOW | SW_VIEWER | SW_SAMPLE | SW_PROCESS | SW_PROGRESS)) || ranges.count > 1)) {
+        // Print out error message and guide user to help command
+        print_error("Batch can only dump a single range of each file, not with -a, -e, -m, -A, -i, -f, -V, -S, -M, -p or -P");
+
+        return 21;
+    }
+
+    if (switches & (SW_WRITE | SW_REUSE))
+        options.verbose = true;     // Every line has its own place in output file (no squeezing)
+
+    // Batch dumps every file into its own output file (first range of each file only),
+    // files are independent of each other so workers pay off whatever their size is
+    if (switches & SW_BATCH) {
+        plan_start(&plan, argv[paths_begin], PLAN_SEQUENTIAL, true, workers, workers_stated);
+        plan_finish(&plan, PLAN_UNKNOWN_SIZE, 1);
+        options.chunk_size = plan.chunk_size;
+
+        if (switches & SW_EXPLAIN)
+            plan_explain(&plan, stderr);
+
+        return dump_batch(argv + paths_begin, argc - paths_begin, directory, format, &options,
+            (ranges.count > 0) ? &ranges.specs[0] : NULL, plan.workers);
+    }
+
+    // Process memory is dumped in place of a file, last argument is the process identifier
+    if (switches & SW_PROCESS) {
+        unsigned long pid;
+
+        if (switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_FOLLOW | SW_VIEWER | SW_SAMPLE | SW_BATCH | SW_WRITE | SW_REUSE | SW_CHECKPOINT)) {
+            // Print out error message and guide user to help command
+            print_error("Process memory can only be dumped to the console, not with -a, -e, -m, -A, -i, -f, -V, -S, -D, -W, -R or -K");
+
+            return 16;
+        }
+
+        if (sscanf_s(argv[argc - 1], "%lu", &pid) != 1) {
+            // Print out error message and guide user to help command
+            print_error("Process must be given by its decimal identifier");
+
+            return 17;
+        }
+
+        // Offsets and lengths are virtual addresses, whole user address space by default
+        range_t resolved[MAX_RANGES];
+        size_t resolved_count = 1;
+        size_t lowest, highest;
+        process_address_space(&lowest, &highest);
+        resolved[0].begin = lowest;
+        resolved[0].end = highest;
+        if (ranges.count > 0)
+            resolved_count = ranges_resolve(&ranges, highest, resolved);
+
+        // Console displays UTF-8 text only with UTF-8 code page (restored at the end)
+        UINT codepage = GetConsoleOutputCP();
+        if (switches & SW_UTF8)
+            SetConsoleOutputCP(CP_UTF8);
+
+        if (output != OUTPUT_TEXT)
+            record_start(stdout, output, checksum);
+
+        size_t address = resolved[0].begin;
+        retcode = dump_process(pid, format, &options, resolved, resolved_count, &address);
+
+        if (switches & SW_UTF8)
+            SetConsoleOutputCP(codepage);   // Restore original code page
+
+        return retcode;
+    }
+
+    // Plan reading from what is known before the file is opened (storage and access mode)
+    int access = PLAN_SEQUENTIAL;
+    if (switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE))
+        access = PLAN_SEQUENTIAL;       // Analysis, strings, signature scan, archive members and C include take precedence over viewer and follow
+    else if (switches & SW_VIEWER)
+        access = PLAN_MAPPED;
+    else if (switches & SW_FOLLOW)
+        access = PLAN_POLLED;
+    else if ((switches & SW_SAMPLE) || ranges.count > 1)
+        access = PLAN_SCATTERED;
+    plan_start(&plan, argv[argc - 1], access, (switches & (SW_ANALYSIS | SW_INCLUDE | SW_WRITE)) != 0, workers, workers_stated);
+
+    // Path is clear, let's try to open the file for reading in binary mode (with caching hint of access mode)
+    file = fopen(argv[argc - 1], plan_open_mode(&plan));
 
     if (!file) {
         // File couldn't be opened for some reason
@@ -331,82 +1085,178 @@ int main(int argc, char** argv) {
         return errno;       // Exit with specific system return code
     }
 
-    // Get the file size
-    fseek(file, 0L, SEEK_END);
-    size_t fsize = ftell(file);
+    // Get the file size (raw device reports its own)
+    size_t fsize = input_prepare(file, &options.alignment);
+
+    // Check if positional writing can read chunks at any offset
+    if ((switches & SW_WRITE) && options.alignment > 1) {
+        // Print out error message and guide user to help command
+        print_error("Output file can only be written from a regular file, not from a raw device");
+        fclose(file);
+
+        return 14;
+    }
+
+    // Analysis, strings, signature scan, follow, viewer and sampling work with the first stated range only
+    offset = length = 0;
+    if (ranges.count > 0) {
+        offset = ranges.specs[0].offset;
+        length = ranges.specs[0].length;
+
+        if (ranges.specs[0].from_end)
+            // Offset from the end of file reaches the file beginning at most
+            offset = (offset < fsize) ? fsize - offset : 0;
+    }
+
+    // Following starts at the end of file unless an offset was stated
+    bool follow = (switches & SW_FOLLOW) && !(switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_VIEWER));
+    if (follow && !offset_stated)
+        offset = fsize;
 
     // If beginning offset is greater than the file size, set it to reach end of file
     if (offset > fsize)
         offset = fsize;
 
-    // If length isn't specified or is 0, set it to reach end of file
+    // If length isn't specified or is 0, set it to reach end of file (or never end when following)
     if (length == 0)
-        length = fsize - offset;
+        length = (follow) ? SIZE_MAX - offset : fsize - offset;
 
     // Get end offset
     size_t endoffset = offset + length;
 
-    // If end offset is greater than the file size, set it to the end of file
-    if (endoffset > fsize)
+    // If end offset is greater than the file size, set it to the end of file (file may grow when following)
+    if (endoffset > fsize && !follow)
         endoffset = fsize;
 
+    // Several ranges are sorted, merged where they overlap and dumped in a single pass
+    range_t resolved[MAX_RANGES];
+    size_t resolved_count = 0;
+    bool sampling = (switches & SW_SAMPLE) && !follow && !(switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_VIEWER));
+    bool multiple = ranges.count > 1 && !follow && !sampling && !(switches & (SW_ANALYSIS | SW_STRINGS | SW_SCAN | SW_ARCHIVE | SW_INCLUDE | SW_VIEWER));
+    if (multiple) {
+        resolved_count = ranges_resolve(&ranges, fsize, resolved);
+        offset = resolved[0].begin;
+        endoffset = resolved[resolved_count - 1].end;
+    }
+
+    // Chunk size and workers are planned for the range to be read
+    plan_finish(&plan, endoffset - offset, options.alignment);
+    options.chunk_size = plan.chunk_size;
+    if (switches & SW_EXPLAIN)
+        plan_explain(&plan, stderr);
+
     // Set current position to the initial offset
     size_t position = offset;
 
     // Set position on file to given offset
-    fseek(file, offset, SEEK_SET);
+    input_seek(file, options.alignment, offset);
+
+    // Start progress reporter if requested (it only watches the position, dump loops stay untouched),
+    // followed file has no end to report progress against, viewer and archive members have no progress at all
+    bool report = (switches & SW_PROGRESS) && !follow && !(switches & (SW_VIEWER | SW_ARCHIVE));
+    if (report)
+        progress_start(&progress, &position, offset, endoffset, switches & SW_PROGRESS_FORCE);
 
-    // File can be opened, now check for dump switches and dump binary contents
-    if ((switches & ~SW_VERBOSE) == SW_DUMP_PLAIN_HEX) {    // Don't interpret a verbose switch
-        // Plain hexadecimal two-byte system-endian representation
-        retcode = dump_plain_hex(file, verbose, offset, &position, endoffset);
+    // Console displays UTF-8 text only with UTF-8 code page (restored at the end)
+    UINT codepage = GetConsoleOutputCP();
+    if (switches & SW_UTF8)
+        SetConsoleOutputCP(CP_UTF8);
+
+    // Analysis replaces the dump output
+    if (switches & SW_ANALYSIS) {
+        // Entropy and byte statistics of each block
+        retcode = analyze_entropy(file, block_size, plan.workers, offset, &position, endoffset);
 
         goto end_procedure;     // End the program after done
     }
 
-    if (switches & SW_DUMP_BYTE_OCTAL) {
-        // Octal one-byte representation
-        retcode = dump_byte_octal(file, verbose, offset, &position, endoffset);
+    // Strings mode replaces the dump output as well
+    if (switches & SW_STRINGS) {
+        // Runs of printable characters with their offsets
+        retcode = extract_strings(file, strings_minimum, strings_utf16, plan.chunk_size, offset, &position, endoffset);
 
         goto end_procedure;     // End the program after done
     }
 
-    if (switches & SW_DUMP_BYTE_CHAR) {
-        // Character one-byte ASCII representation
-        retcode = dump_byte_char(file, verbose, offset, &position, endoffset);
+    // Signature scan replaces the dump output as well
+    if (switches & SW_SCAN) {
+        // Offset and type of each embedded structure
+        retcode = scan_file(file, scan_user, scan_count, scan_window, &options, offset, &position, endoffset);
 
         goto end_procedure;     // End the program after done
     }
 
-    if (switches & SW_DUMP_CANONICAL) {
-        // Canonical HEX+ASCII one-byte representation
-        retcode = dump_canonical(file, verbose, offset, &position, endoffset);
+    // Archive members replace the dump of the whole file
+    if (switches & SW_ARCHIVE) {
+        // Stored members straight from the archive, deflated ones as they are decompressed
+        retcode = archive_dump(file, fsize, member, format, &options, (ranges.count > 0) ? &ranges.specs[0] : NULL);
 
         goto end_procedure;     // End the program after done
     }
 
-    if (switches & SW_DUMP_WORD_DECIMAL) {
-        // Decimal aligned two-byte system-endian representation
-        retcode = dump_word_decimal(file, verbose, offset, &position, endoffset);
+    // C include replaces the dump with an array declaration (xxd -i layout)
+    if (switches & SW_INCLUDE) {
+        // Twelve bytes per line unless width was stated, lines are rendered by workers
+        retcode = include_file(file, argv[argc - 1], (width_stated) ? width : INCLUDE_DEFAULT_WIDTH, plan.workers, offset, &position, endoffset);
 
         goto end_procedure;     // End the program after done
     }
 
-    if (switches & SW_DUMP_WORD_OCTAL) {
-        // Octal aligned two-byte system-endian representation
-        retcode = dump_word_octal(file, verbose, offset, &position, endoffset);
+    // Viewer renders the visible lines only, canonical display unless stated otherwise
+    if (switches & SW_VIEWER) {
+        if (!(switches & SW_DUMP_MASK) && !typed_set)
+            format = &format_canonical;
+
+        retcode = view_file(argv[argc - 1], format, width, offset);
 
         goto end_procedure;     // End the program after done
     }
 
-    if (switches & SW_DUMP_WORD_HEX) {
-        // Hexadecimal aligned two-byte system-endian representation
-        retcode = dump_word_hex(file, verbose, offset, &position, endoffset);
+    // Workers write their chunks right where they belong in output file
+    if (switches & SW_WRITE) {
+        retcode = write_file(argv[argc - 1], target, format, &options, offset, &position, endoffset, plan.workers);
 
-        // End the program after done -> last branch, doesn't require goto statement
+        goto end_procedure;     // End the program after done
     }
-    
+
+    // Blocks unchanged since the previous dump are copied from it
+    if (switches & SW_REUSE) {
+        retcode = reuse_dump(file, dumpfile, format, &options, offset, &position, endoffset);
+
+        goto end_procedure;     // End the program after done
+    }
+
+    // State of a long dump is recorded on the way, so an interrupted one continues where it left off
+    if (switches & SW_CHECKPOINT) {
+        retcode = checkpoint_dump(file, argv[argc - 1], checkpointed, resume, format, &options, fsize, offset, &position, endoffset);
+
+        goto end_procedure;     // End the program after done
+    }
+
+    // Structured records replace the display format
+    if (output != OUTPUT_TEXT)
+        record_start(stdout, output, checksum);
+
+    // Dump binary contents
+    if (follow)
+        // Keep dumping data appended to file
+        retcode = follow_file(file, argv[argc - 1], format, &options, offset, &position, endoffset);
+    else if (sampling)
+        // Dump only the beginning of every stride (one line by default)
+        retcode = sample_file(file, format, &options, offset, &position, endoffset, stride, (sample > 0) ? sample : width);
+    else if (multiple)
+        // Dump each range with its own offsets
+        retcode = dump_ranges(file, format, &options, resolved, resolved_count, &position);
+    else
+        retcode = dump_file(file, format, &options, offset, &position, endoffset);
+
     end_procedure:
+    if (report)
+        progress_stop(&progress);   // Print final progress state
+
+    if (switches & SW_UTF8)
+        SetConsoleOutputCP(codepage);   // Restore original code page
+
     fclose(file);               // Tidy up
 
     return retcode;             // Return the retcode
@@ -0,0 +1,155 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: plan.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <windows.h>
+
+// Local definitions
+#include "plan.h"
+#include "workers.h"
+
+// Check if path lies on network storage - static function
+static bool is_remote(const char* path) {
+    char root[] = "?:\\";
+
+    if (strncmp(path, "\\\\?\\UNC\\", 8) == 0)
+        return true;        // Long UNC path
+    if (strncmp(path, "\\\\?\\", 4) == 0)
+        path += 4;          // Long path, drive follows
+    else if (strncmp(path, "\\\\.\\", 4) == 0)
+        return false;       // Device
+    else if ((path[0] == '\\' || path[0] == '/') && (path[1] == '\\' || path[1] == '/'))
+        return true;        // UNC path \\server\share
+
+    if (isalpha((unsigned char)path[0]) && path[1] == ':') {
+        // Drive letter (mapped network drive is remote as well)
+        root[0] = path[0];
+        return GetDriveTypeA(root) == DRIVE_REMOTE;
+    }
+
+    // Relative path lies on current drive
+    return GetDriveTypeA(NULL) == DRIVE_REMOTE;
+}
+
+// Print amount of bytes in readable units - static function
+static void print_amount(FILE* out, size_t bytes) {
+    if (bytes >= 1048576 && bytes % 1048576 == 0)
+        fprintf(out, "%llu MiB", (unsigned long long)(bytes / 1048576));
+    else if (bytes >= 1024 && bytes % 1024 == 0)
+        fprintf(out, "%llu KiB", (unsigned long long)(bytes / 1024));
+    else
+        fprintf(out, "%llu bytes", (unsigned long long)bytes);
+}
+
+// Start plan from what is known before opening input
+void plan_start(plan_t* plan, const char* path, int access, bool parallel, unsigned int workers, bool workers_stated) {
+    plan->path = path;
+    plan->remote = is_remote(path);
+    plan->device = false;
+    plan->access = access;
+    plan->parallel = parallel;
+    plan->workers_stated = workers_stated;
+    plan->processors = get_worker_count(0);
+    plan->size = 0;
+    plan->chunk_size = PLAN_SMALL_CHUNK;
+    plan->workers = workers;
+}
+
+// Get mode of fopen with caching hint of access mode
+const char* plan_open_mode(const plan_t* plan) {
+    switch (plan->access) {
+    case PLAN_SEQUENTIAL:
+        return "rbS";       // Read ahead aggressively
+    case PLAN_SCATTERED:
+        return "rbR";       // Don't read ahead past the pieces
+    default:
+        return "rb";
+    }
+}
+
+// Choose chunk size and number of workers for size of range
+void plan_finish(plan_t* plan, size_t size, size_t alignment) {
+    plan->size = size;
+    plan->device = alignment > 1;
+
+    // Large chunks pay off for long sequential reads only, reading gaps along costs less in small ones,
+    // network storage prefers fewer larger requests
+    if (plan->access == PLAN_SCATTERED || size < PLAN_LARGE_RANGE)
+        plan->chunk_size = PLAN_SMALL_CHUNK;
+    else if (plan->remote)
+        plan->chunk_size = PLAN_REMOTE_CHUNK;
+    else
+        plan->chunk_size = PLAN_LOCAL_CHUNK;
+
+    // Stated number of workers is kept, otherwise workers are used for large ranges only
+    // (and for batch, whose files don't depend on each other)
+    if (plan->workers_stated)
+        plan->workers = get_worker_count(plan->workers);
+    else if (!plan->parallel || size < PLAN_PARALLEL_RANGE)
+        plan->workers = 1;
+    else if (plan->remote && plan->processors > PLAN_REMOTE_WORKERS)
+        plan->workers = PLAN_REMOTE_WORKERS;
+    else
+        plan->workers = plan->processors;
+}
+
+// Print chosen plan
+void plan_explain(const plan_t* plan, FILE* out) {
+    fprintf(out, "Plan for %s\n", plan->path);
+
+    // Input
+    fprintf(out, "  Input:    %s on %s storage, ", (plan->device) ? "raw device" : "file", (plan->remote) ? "network" : "local");
+    if (plan->size == PLAN_UNKNOWN_SIZE)
+        fprintf(out, "size of each file is known when it's dumped\n");
+    else {
+        print_amount(out, plan->size);
+        fprintf(out, " to read\n");
+    }
+
+    // Reading
+    fprintf(out, "  Reading:  ");
+    switch (plan->access) {
+    case PLAN_MAPPED:
+        fprintf(out, "mapped view of visible lines\n");
+        break;
+    case PLAN_POLLED:
+        print_amount(out, PLAN_SMALL_CHUNK);
+        fprintf(out, " chunks as data are appended\n");
+        break;
+    default:
+        print_amount(out, plan->chunk_size);
+        fprintf(out, " chunks, %s access hint (%s)\n",
+            (plan->access == PLAN_SCATTERED) ? "random" : "sequential",
+            (plan->access == PLAN_SCATTERED) ? "pieces of range are read" :
+            (plan->size == PLAN_UNKNOWN_SIZE) ? "whole files" :
+            (plan->size < PLAN_LARGE_RANGE) ? "range below 16 MiB" :
+            (plan->remote) ? "large range on network storage" : "large range");
+    }
+
+    // Workers
+    fprintf(out, "  Workers:  ");
+    if (!plan->parallel)
+        fprintf(out, "1 (mode runs on a single thread)\n");
+    else if (plan->workers_stated)
+        fprintf(out, "%u (stated by -j)\n", plan->workers);
+    else
+        fprintf(out, "%u of %u processors (%s)\n", plan->workers, plan->processors,
+            (plan->size == PLAN_UNKNOWN_SIZE) ? "files are dumped independently" :
+            (plan->size < PLAN_PARALLEL_RANGE) ? "range below 64 MiB" :
+            (plan->remote && plan->workers < plan->processors) ? "network storage" : "large range");
+}
@@ -0,0 +1,74 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: plan.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#ifndef __PLAN_H__
+#define __PLAN_H__
+
+// Define constants
+#define PLAN_EXPLAIN_SWITCH             "--explain" // Long switch printing the plan
+#define PLAN_SMALL_CHUNK                65536       // Chunk of small ranges and of scattered reads (gaps are read along)
+#define PLAN_LOCAL_CHUNK                1048576     // Chunk of large ranges on local storage and devices
+#define PLAN_REMOTE_CHUNK               4194304     // Chunk of large ranges on network storage (fewer round trips)
+#define PLAN_LARGE_RANGE                16777216    // Range from which large chunks pay off
+#define PLAN_PARALLEL_RANGE             67108864    // Range from which workers pay off
+#define PLAN_REMOTE_WORKERS             4           // Most workers reading network storage at once
+#define PLAN_UNKNOWN_SIZE               ((size_t)-1)    // Size isn't known upfront (batch)
+
+// Access modes
+#define PLAN_SEQUENTIAL                 0           // Range is read from beginning to end
+#define PLAN_SCATTERED                  1           // Pieces of range are read (sampling, several ranges)
+#define PLAN_MAPPED                     2           // Visible part of file is mapped (viewer)
+#define PLAN_POLLED                     3           // Appended data are read as they come (follow)
+
+// Input and reading strategy
+typedef struct plan {
+    const char* path;                   // Input path
+    bool remote;                        // Input lies on network storage
+    bool device;                        // Input is a raw device
+    int access;                         // Access mode
+    bool parallel;                      // Mode uses workers
+    bool workers_stated;                // Number of workers was stated on command line
+    unsigned int processors;            // Logical processors
+    size_t size;                        // Bytes to be read
+    size_t chunk_size;                  // Bytes read at once
+    unsigned int workers;               // Worker threads
+} plan_t;
+
+// Declare functions
+void plan_start(
+    plan_t* plan,
+    const char* path,
+    int access,
+    bool parallel,
+    unsigned int workers,
+    bool workers_stated
+);      // Start plan from what is known before opening input (storage, access mode)
+const char* plan_open_mode(
+    const plan_t* plan
+);      // Get mode of fopen with caching hint of access mode
+void plan_finish(
+    plan_t* plan,
+    size_t size,
+    size_t alignment
+);      // Choose chunk size and number of workers for size of range
+void plan_explain(
+    const plan_t* plan,
+    FILE* out
+);      // Print chosen plan
+
+#endif
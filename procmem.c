@@ -0,0 +1,134 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: procmem.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <windows.h>
+
+// Local definitions
+#include "procmem.h"
+#include "dumps.h"
+#include "ranges.h"
+#include "info.h"
+
+// Page protections that allow reading
+#define PAGE_READABLE (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)
+
+// Check if region of memory can be read - static function
+static bool is_readable(const MEMORY_BASIC_INFORMATION* region) {
+    return region->State == MEM_COMMIT && (region->Protect & PAGE_READABLE) && !(region->Protect & PAGE_GUARD);
+}
+
+// Dump readable memory of a region within range - static function
+static bool dump_region(HANDLE process, dump_state_t* state, ubyte_t* chunk, size_t begin, size_t end, size_t* position) {
+    while (begin < end) {
+        // Read next chunk of the region
+        size_t count = (end - begin < PROCESS_CHUNK_SIZE) ? end - begin : PROCESS_CHUNK_SIZE;
+        SIZE_T successfully_read = 0;
+
+        if (!ReadProcessMemory(process, (LPCVOID)begin, chunk, count, &successfully_read) && successfully_read == 0)
+            // Region was released or protected meanwhile, rest of it is a gap
+            return false;
+
+        dump_skip(state, begin);
+        dump_feed(state, chunk, successfully_read);
+        begin += successfully_read;
+        *position = begin;
+    }
+
+    return true;
+}
+
+// Get lowest and highest address of user address space
+void process_address_space(size_t* begin, size_t* end) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    *begin = (size_t)info.lpMinimumApplicationAddress;
+    *end = (size_t)info.lpMaximumApplicationAddress + 1;
+}
+
+// Dump readable memory of a process in given address ranges
+int dump_process(
+    unsigned long pid,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_t* ranges,
+    size_t count,
+    size_t* position
+) {
+    HANDLE process = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
+
+    if (!process) {
+        // Process doesn't exist or isn't accessible
+        errno = (GetLastError() == ERROR_ACCESS_DENIED) ? EACCES : ESRCH;
+        print_file_error("Process couldn\'t be opened");
+
+        return errno;
+    }
+
+    dump_state_t state;
+    ubyte_t* chunk = malloc(PROCESS_CHUNK_SIZE);
+
+    if (!chunk) {
+        // Not enough memory for buffer
+        CloseHandle(process);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        // Each range is dumped with its own ending address
+        if (!dump_init(&state, format, options, stdout, ranges[i].begin, ranges[i].end)) {
+            // Not enough memory for buffers
+            free(chunk);
+            CloseHandle(process);
+            print_error_memory("Out of memory");
+
+            return ENOMEM;
+        }
+
+        size_t address = ranges[i].begin;
+        *position = address;
+
+        while (address < ranges[i].end) {
+            // Walk regions of the range, only readable ones are read
+            MEMORY_BASIC_INFORMATION region;
+            if (VirtualQueryEx(process, (LPCVOID)address, &region, sizeof(region)) == 0)
+                break;      // Beyond the last region
+
+            size_t region_end = (size_t)region.BaseAddress + region.RegionSize;
+            size_t end = (region_end < ranges[i].end) ? region_end : ranges[i].end;
+
+            if (is_readable(&region))
+                dump_region(process, &state, chunk, address, end, position);
+
+            address = end;
+        }
+
+        // Unreadable memory up to the end of range is marked as well
+        dump_skip(&state, ranges[i].end);
+        *position = ranges[i].end;
+        dump_end(&state);
+    }
+
+    free(chunk);
+    CloseHandle(process);
+
+    return 0;
+}
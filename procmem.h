@@ -0,0 +1,39 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: procmem.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include "dumps.h"                      // Measure for dump format and options
+#include "ranges.h"                     // Measure for address ranges
+#ifndef __PROCMEM_H__
+#define __PROCMEM_H__
+
+// Define constants
+#define PROCESS_CHUNK_SIZE              1048576     // Bytes read from process at once
+
+// Declare functions
+void process_address_space(
+    size_t* begin,
+    size_t* end
+);      // Get lowest and highest address of user address space
+int dump_process(
+    unsigned long pid,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_t* ranges,
+    size_t count,
+    size_t* position
+);      // Dump readable memory of a process in given address ranges, unreadable gaps are marked
+
+#endif
@@ -0,0 +1,111 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: progress.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <io.h>
+#include <windows.h>
+
+// Local definitions
+#include "progress.h"
+
+// Print single progress report - static function
+static void progress_report(progress_t* progress, bool last) {
+    unsigned long long now = GetTickCount64();      // Current tick count
+    size_t position = *progress->position;          // Snapshot of the watched position
+
+    // Position may lag behind or run past the range bounds while seeking
+    if (position < progress->begin)
+        position = progress->begin;
+    if (position > progress->end)
+        position = progress->end;
+
+    size_t done = position - progress->begin;               // Bytes done so far
+    size_t total = progress->end - progress->begin;         // Bytes to be done in total
+
+    // Percentage of the range done (empty range is done from the start)
+    double percent = (total > 0) ? 100.0 * done / total : 100.0;
+
+    // Current throughput is measured since the last report
+    double seconds = (now - progress->last_time) / 1000.0;
+    double rate = (seconds > 0) ? (position - progress->last_position) / seconds / PROGRESS_MEGABYTE : 0;
+
+    // Estimated time left is based on the average throughput since the start
+    double elapsed = (now - progress->start_time) / 1000.0;
+    unsigned long long eta = (done > 0) ? (unsigned long long)((total - done) * elapsed / done) : 0;
+
+    // Console line is rewritten in place, redirected output gets a new line each time
+    fprintf(stderr, "%s%6.2f%%  %9.2f MB/s  ETA %02llu:%02llu:%02llu%s",
+        (progress->console) ? "\r" : "",
+        percent, rate, eta / 3600, eta / 60 % 60, eta % 60,
+        (progress->console && !last) ? "" : "\n");
+
+    // Remember the state for next throughput measurement
+    progress->last_time = now;
+    progress->last_position = position;
+}
+
+// Timer callback - static function
+static VOID CALLBACK progress_tick(PVOID parameter, BOOLEAN fired) {
+    progress_report((progress_t*)parameter, false);
+}
+
+// Start reporting progress
+bool progress_start(
+    progress_t* progress,
+    volatile size_t* position,
+    size_t begin,
+    size_t end,
+    bool forced
+) {
+    // Initialize reporter state
+    progress->timer = NULL;
+    progress->position = position;
+    progress->begin = begin;
+    progress->end = end;
+    progress->start_time = progress->last_time = GetTickCount64();
+    progress->last_position = begin;
+    progress->console = _isatty(_fileno(stderr));
+
+    if (!progress->console && !forced)
+        // Standard error output is redirected and reporting wasn't forced -> stay silent
+        return false;
+
+    // Reports are issued from a thread pool timer, the dump loops aren't touched at all
+    DWORD interval = (progress->console) ? PROGRESS_INTERVAL_CONSOLE : PROGRESS_INTERVAL_REDIRECT;
+    HANDLE timer = NULL;
+
+    if (!CreateTimerQueueTimer(&timer, NULL, progress_tick, progress, interval, interval, WT_EXECUTEDEFAULT))
+        // Timer couldn't be created -> just dump without progress
+        return false;
+
+    progress->timer = timer;
+    return true;
+}
+
+// Stop reporting progress
+void progress_stop(progress_t* progress) {
+    if (!progress->timer)
+        // Reporter isn't running
+        return;
+
+    // Delete timer and wait for a running callback to finish
+    DeleteTimerQueueTimer(NULL, (HANDLE)progress->timer, INVALID_HANDLE_VALUE);
+    progress->timer = NULL;
+
+    // Print out final state
+    progress_report(progress, true);
+}
@@ -0,0 +1,52 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: progress.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdbool.h>                    // Measure for boolean type
+#ifndef __PROGRESS_H__
+#define __PROGRESS_H__
+
+// Report intervals (in milliseconds)
+#define PROGRESS_INTERVAL_CONSOLE       500         // Console line is rewritten in place
+#define PROGRESS_INTERVAL_REDIRECT      10000       // Redirected stderr gets a new line each time
+
+// Throughput unit
+#define PROGRESS_MEGABYTE               1048576.0
+
+// Progress reporter state
+typedef struct progress {
+    void* timer;                        // Timer queue timer handle (NULL if not running)
+    volatile size_t* position;          // Position updated by the dump loop
+    size_t begin;                       // Initial offset
+    size_t end;                         // End offset
+    unsigned long long start_time;      // Tick count at start
+    unsigned long long last_time;       // Tick count of last report
+    size_t last_position;               // Position at last report
+    bool console;                       // Standard error output is a console
+} progress_t;
+
+// Declare functions
+bool progress_start(
+    progress_t* progress,
+    volatile size_t* position,
+    size_t begin,
+    size_t end,
+    bool forced
+);      // Start reporting progress of given position
+void progress_stop(
+    progress_t* progress
+);      // Stop reporting and print final state
+
+#endif
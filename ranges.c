@@ -0,0 +1,276 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: ranges.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// Local definitions
+#include "ranges.h"
+#include "device.h"
+#include "dumps.h"
+#include "info.h"
+
+// Get range stated last, or start a new one if given part is already set - static function
+static range_spec_t* next_spec(range_list_t* list, bool length) {
+    if (list->count > 0) {
+        // Offset and length of a range can be stated in any order
+        range_spec_t* last = &list->specs[list->count - 1];
+        if (!((length) ? last->length_set : last->offset_set))
+            return last;
+    }
+
+    if (list->count == MAX_RANGES)
+        // No more room
+        return NULL;
+
+    range_spec_t* spec = &list->specs[list->count++];
+    spec->offset = spec->length = 0;
+    spec->from_end = spec->offset_set = spec->length_set = false;
+
+    return spec;
+}
+
+// Add offset to last range or start a new one
+bool ranges_add_offset(range_list_t* list, size_t offset, bool from_end) {
+    range_spec_t* spec = next_spec(list, false);
+    if (!spec)
+        return false;
+
+    spec->offset = offset;
+    spec->from_end = from_end;
+    spec->offset_set = true;
+
+    return true;
+}
+
+// Add length to last range or start a new one
+bool ranges_add_length(range_list_t* list, size_t length) {
+    range_spec_t* spec = next_spec(list, true);
+    if (!spec)
+        return false;
+
+    spec->length = length;
+    spec->length_set = true;
+
+    return true;
+}
+
+// Resolve single range against file size
+void range_resolve(const range_spec_t* spec, size_t fsize, range_t* range) {
+    // Offset from the end of file reaches the file beginning at most,
+    // offset past the end of file is set to reach the end of file
+    if (spec->from_end)
+        range->begin = (spec->offset < fsize) ? fsize - spec->offset : 0;
+    else
+        range->begin = (spec->offset < fsize) ? spec->offset : fsize;
+
+    // Zero length means until end of file, range never reaches past it
+    if (spec->length == 0 || spec->length > fsize - range->begin)
+        range->end = fsize;
+    else
+        range->end = range->begin + spec->length;
+}
+
+// Compare initial offsets of two ranges - static function
+static int compare_ranges(const void* a, const void* b) {
+    const range_t* left = (const range_t*)a;
+    const range_t* right = (const range_t*)b;
+
+    if (left->begin != right->begin)
+        return (left->begin < right->begin) ? -1 : 1;
+    return (left->end < right->end) ? -1 : (left->end > right->end);
+}
+
+// Resolve, sort and merge overlapping ranges
+size_t ranges_resolve(const range_list_t* list, size_t fsize, range_t* ranges) {
+    for (size_t i = 0; i < list->count; ++i)
+        range_resolve(&list->specs[i], fsize, &ranges[i]);
+
+    // Ranges are dumped in file order so the file is passed only once
+    qsort(ranges, list->count, sizeof(range_t), compare_ranges);
+
+    size_t count = 0;
+    for (size_t i = 0; i < list->count; ++i) {
+        if (count > 0 && ranges[i].begin < ranges[count - 1].end) {
+            // Overlaps previous range -> extend it
+            if (ranges[i].end > ranges[count - 1].end)
+                ranges[count - 1].end = ranges[i].end;
+        }
+        else
+            // Separate range
+            ranges[count++] = ranges[i];
+    }
+
+    return count;
+}
+
+// Get end of a coalesced read starting at given position - static function
+static size_t get_read_end(const range_t* ranges, size_t count, size_t current, size_t position, size_t chunk_size) {
+    // Ranges starting within the same chunk are read along with the current one,
+    // skipping over small gaps costs less than another seek and read
+    size_t limit = (ranges[current].end - position < chunk_size) ? ranges[current].end : position + chunk_size;
+
+    for (size_t i = current + 1; i < count && ranges[i].begin < position + chunk_size; ++i) {
+        size_t end = (ranges[i].end - position < chunk_size) ? ranges[i].end : position + chunk_size;
+        if (end > limit)
+            limit = end;
+    }
+
+    return limit;
+}
+
+// Dump each range with its own offsets in a single pass over file
+int dump_ranges(
+    FILE* file,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_t* ranges,
+    size_t count,
+    size_t* position
+) {
+    dump_state_t state;
+    ubyte_t* chunk = malloc(options->chunk_size);
+    size_t chunk_begin, chunk_end;      // Part of file held in chunk
+    chunk_begin = chunk_end = 0;
+    bool positioned = false;            // File position is at the chunk end
+
+    if (!chunk) {
+        // Not enough memory for buffers
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        // Every range has its own offset column and ending offset
+        if (!dump_init(&state, format, options, stdout, ranges[i].begin, ranges[i].end)) {
+            // Not enough memory for buffers
+            free(chunk);
+            print_error_memory("Out of memory");
+
+            return ENOMEM;
+        }
+
+        *position = ranges[i].begin;
+
+        while (*position < ranges[i].end) {
+            if (*position < chunk_begin || *position >= chunk_end) {
+                // Range isn't in chunk, read next one (seek only if it doesn't follow the last read)
+                size_t read_end = get_read_end(ranges, count, i, *position, options->chunk_size);
+
+                if (!positioned || *position != chunk_end)
+                    input_seek(file, options->alignment, *position);
+
+                size_t successfully_read = fread(chunk, BYTE_SIZE, read_end - *position, file);
+                chunk_begin = *position;
+                chunk_end = *position + successfully_read;
+                positioned = true;
+
+                if (successfully_read < read_end - *position) {
+                    // An error occured while reading file, dump what was read of current range
+                    if (chunk_end > ranges[i].end)
+                        chunk_end = ranges[i].end;
+                    dump_feed(&state, chunk, chunk_end - *position);
+                    *position = chunk_end;
+                    dump_flush(&state);
+
+                    putchar('\n');      // Divide space between data and error message
+                    print_file_error("An error occured while file contents output");
+
+                    free(state.buffer);
+                    free(chunk);
+                    return errno;       // End with specific return code for given error
+                }
+            }
+
+            // Dump the part of the range held in chunk
+            size_t end = (chunk_end < ranges[i].end) ? chunk_end : ranges[i].end;
+            dump_feed(&state, chunk + (*position - chunk_begin), end - *position);
+            *position = end;
+        }
+
+        dump_end(&state);
+    }
+
+    free(chunk);
+
+    return 0;
+}
+
+// Dump first bytes of every stride of a range, skipping the rest
+int sample_file(
+    FILE* file,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset,
+    size_t stride,
+    size_t sample
+) {
+    dump_state_t state;
+    ubyte_t* chunk = malloc(options->chunk_size);
+
+    if (!chunk || !dump_init(&state, format, options, stdout, offset, endoffset)) {
+        // Not enough memory for buffers
+        free(chunk);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    // Samples longer than stride cover everything
+    if (sample > stride)
+        sample = stride;
+
+    for (size_t begin = offset; begin < endoffset; begin = (endoffset - begin > stride) ? begin + stride : endoffset) {
+        // Only sampled bytes are ever read, the rest of each stride is seeked over
+        size_t end = (endoffset - begin > sample) ? begin + sample : endoffset;
+
+        if (*position != begin) {
+            dump_skip(&state, begin);
+            input_seek(file, options->alignment, begin);
+            *position = begin;
+        }
+
+        while (*position < end) {
+            // Read next chunk of the sample
+            size_t count = (end - *position < options->chunk_size) ? end - *position : options->chunk_size;
+            size_t successfully_read = fread(chunk, BYTE_SIZE, count, file);
+
+            dump_feed(&state, chunk, successfully_read);
+            *position += successfully_read;
+
+            if (successfully_read < count) {
+                // An error occured while reading file
+                dump_flush(&state);
+
+                putchar('\n');      // Divide space between data and error message
+                print_file_error("An error occured while file contents output");
+
+                free(state.buffer);
+                free(chunk);
+                return errno;       // End with specific return code for given error
+            }
+        }
+    }
+
+    dump_end(&state);
+    free(chunk);
+
+    return 0;
+}
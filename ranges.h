@@ -0,0 +1,86 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: ranges.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for dump format and options
+#ifndef __RANGES_H__
+#define __RANGES_H__
+
+// Define constants
+#define MAX_RANGES                      64          // Most ranges dumped at once
+
+// Range as stated on command line
+typedef struct range_spec {
+    size_t offset;                      // Offset (-s)
+    size_t length;                      // Length (-n), zero means until end of file
+    bool from_end;                      // Offset is counted from the end of file
+    bool offset_set;                    // Offset was stated
+    bool length_set;                    // Length was stated
+} range_spec_t;
+
+// Ranges stated on command line
+typedef struct range_list {
+    range_spec_t specs[MAX_RANGES];     // Ranges in order of appearance
+    size_t count;                       // Number of ranges
+} range_list_t;
+
+// Range resolved against file size
+typedef struct range {
+    size_t begin;                       // Initial offset
+    size_t end;                         // End offset
+} range_t;
+
+// Declare functions
+bool ranges_add_offset(
+    range_list_t* list,
+    size_t offset,
+    bool from_end
+);      // Add offset to last range or start a new one (false if there are too many)
+bool ranges_add_length(
+    range_list_t* list,
+    size_t length
+);      // Add length to last range or start a new one (false if there are too many)
+void range_resolve(
+    const range_spec_t* spec,
+    size_t fsize,
+    range_t* range
+);      // Resolve single range against file size
+size_t ranges_resolve(
+    const range_list_t* list,
+    size_t fsize,
+    range_t* ranges
+);      // Resolve, sort and merge overlapping ranges, returns number of resulting ranges
+int dump_ranges(
+    FILE* file,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    const range_t* ranges,
+    size_t count,
+    size_t* position
+);      // Dump each range with its own offsets in a single pass over file
+int sample_file(
+    FILE* file,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset,
+    size_t stride,
+    size_t sample
+);      // Dump first bytes of every stride of a range, skipping the rest
+
+#endif
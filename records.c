@@ -0,0 +1,241 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: records.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <io.h>
+#include <fcntl.h>
+
+// Local definitions
+#include "records.h"
+#include "dumps.h"
+#include "checksum.h"
+
+// Record text pieces
+#define JSON_OFFSET                     "{\"offset\":"
+#define JSON_DATA                       ",\"data\":\""
+#define JSON_END                        "}\n"
+#define CSV_HEADER                      "offset,data"
+
+// Two hexadecimal digits of every byte value (filled on first use)
+static char hex_pairs[256][2];
+static bool hex_pairs_ready = false;
+
+// Base64 alphabet
+static const char base64_digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Copy string literal to output
+#define PUT_LITERAL(out, literal) (memcpy((out), (literal), sizeof(literal) - 1), (out) + sizeof(literal) - 1)
+
+// Put decimal number - static function
+static char* put_decimal(char* out, uqword_t value) {
+    // Digits are produced from the right into a scratch buffer
+    char digits[20];
+    size_t count = 0;
+
+    do {
+        digits[sizeof(digits) - ++count] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    memcpy(out, digits + sizeof(digits) - count, count);
+    return out + count;
+}
+
+// Put hexadecimal number of given digits - static function
+static char* put_hex(char* out, uqword_t value, size_t digits) {
+    for (size_t i = digits; i > 0; --i, value >>= 4)
+        out[i - 1] = "0123456789abcdef"[value & 0xf];
+
+    return out + digits;
+}
+
+// Put little endian number of given size - static function
+static char* put_little_endian(char* out, uqword_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i, value >>= 8)
+        out[i] = (char)(value & 0xff);
+
+    return out + size;
+}
+
+// Put data encoded as hexadecimal digits - static function
+static char* put_data_hex(char* out, const ubyte_t* data, size_t count) {
+    // Whole digit pairs are copied at once
+    for (size_t i = 0; i < count; ++i, out += 2)
+        memcpy(out, hex_pairs[data[i]], 2);
+
+    return out;
+}
+
+// Put data encoded as Base64 - static function
+static char* put_data_base64(char* out, const ubyte_t* data, size_t count) {
+    // Every three bytes make four characters
+    size_t i = 0;
+    for (; i + 3 <= count; i += 3, out += 4) {
+        unsigned int group = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        out[0] = base64_digits[group >> 18];
+        out[1] = base64_digits[(group >> 12) & 0x3f];
+        out[2] = base64_digits[(group >> 6) & 0x3f];
+        out[3] = base64_digits[group & 0x3f];
+    }
+
+    if (i < count) {
+        // One or two bytes left, padded to four characters
+        unsigned int group = (data[i] << 16) | ((i + 1 < count) ? data[i + 1] << 8 : 0);
+        out[0] = base64_digits[group >> 18];
+        out[1] = base64_digits[(group >> 12) & 0x3f];
+        out[2] = (i + 1 < count) ? base64_digits[(group >> 6) & 0x3f] : '=';
+        out[3] = '=';
+        out += 4;
+    }
+
+    return out;
+}
+
+// Put data in given encoding - static function
+static char* put_data(char* out, int encoding, const ubyte_t* data, size_t count) {
+    return (encoding == ENCODING_BASE64) ? put_data_base64(out, data, count) : put_data_hex(out, data, count);
+}
+
+// Get output kind and encoding from specification
+int record_parse(const char* string, int* encoding) {
+    // Specification is an output name, optionally followed by a colon and an encoding name
+    const char* colon = strchr(string, ':');
+    size_t namelen = (colon) ? (size_t)(colon - string) : strlen(string);
+    int output = OUTPUT_TEXT;
+
+    if (namelen == strlen(OUTPUT_NAME_JSON) && strncmp(string, OUTPUT_NAME_JSON, namelen) == 0)
+        output = OUTPUT_JSON;
+    else if (namelen == strlen(OUTPUT_NAME_CSV) && strncmp(string, OUTPUT_NAME_CSV, namelen) == 0)
+        output = OUTPUT_CSV;
+    else if (namelen == strlen(OUTPUT_NAME_BINARY) && strncmp(string, OUTPUT_NAME_BINARY, namelen) == 0)
+        output = OUTPUT_BINARY;
+
+    *encoding = ENCODING_HEX;
+
+    if (!colon)
+        return output;
+
+    if (output == OUTPUT_BINARY)
+        // Binary records hold raw data, there is nothing to encode
+        return OUTPUT_TEXT;
+
+    if (strcmp(colon + 1, ENCODING_NAME_BASE64) == 0)
+        *encoding = ENCODING_BASE64;
+    else if (strcmp(colon + 1, ENCODING_NAME_HEX) != 0)
+        // Unknown encoding
+        return OUTPUT_TEXT;
+
+    return output;
+}
+
+// Prepare tables of serializer
+void record_prepare(void) {
+    if (hex_pairs_ready)
+        return;
+
+    // Fill digit pairs table
+    for (int i = 0; i < 256; ++i) {
+        hex_pairs[i][0] = "0123456789abcdef"[i >> 4];
+        hex_pairs[i][1] = "0123456789abcdef"[i & 0xf];
+    }
+
+    hex_pairs_ready = true;
+}
+
+// Prepare output stream and write CSV header
+void record_start(FILE* out, int output, int checksum) {
+    record_prepare();
+
+    if (output == OUTPUT_BINARY)
+        // Line feeds of binary records must not be translated
+        _setmode(_fileno(out), _O_BINARY);
+
+    if (output == OUTPUT_CSV) {
+        // Column names, checksum column is named after its algorithm
+        fputs(CSV_HEADER, out);
+        if (checksum != CHECKSUM_NONE)
+            fprintf(out, ",%s", checksum_name(checksum));
+        fputc('\n', out);
+    }
+}
+
+// Serialize single record
+char* record_put(
+    char* out,
+    int output,
+    int encoding,
+    uqword_t offset,
+    const ubyte_t* data,
+    size_t count,
+    int checksum,
+    uqword_t sum
+) {
+    switch (output) {
+    case OUTPUT_JSON:
+        // {"offset":<offset>,"data":"<data>"[,"<algorithm>":"<checksum>"]}
+        out = PUT_LITERAL(out, JSON_OFFSET);
+        out = put_decimal(out, offset);
+        out = PUT_LITERAL(out, JSON_DATA);
+        out = put_data(out, encoding, data, count);
+        *out++ = '"';
+
+        if (checksum != CHECKSUM_NONE) {
+            // Checksum is named after its algorithm
+            const char* name = checksum_name(checksum);
+            *out++ = ',';
+            *out++ = '"';
+            memcpy(out, name, strlen(name));
+            out += strlen(name);
+            *out++ = '"';
+            *out++ = ':';
+            *out++ = '"';
+            out = put_hex(out, sum, checksum_digits(checksum));
+            *out++ = '"';
+        }
+
+        out = PUT_LITERAL(out, JSON_END);
+        break;
+
+    case OUTPUT_CSV:
+        // <offset>,<data>[,<checksum>]
+        out = put_decimal(out, offset);
+        *out++ = ',';
+        out = put_data(out, encoding, data, count);
+
+        if (checksum != CHECKSUM_NONE) {
+            *out++ = ',';
+            out = put_hex(out, sum, checksum_digits(checksum));
+        }
+
+        *out++ = '\n';
+        break;
+
+    case OUTPUT_BINARY:
+        // Offset, length, raw data and optional checksum
+        out = put_little_endian(out, offset, RECORD_OFFSET_SIZE);
+        out = put_little_endian(out, count, RECORD_LENGTH_SIZE);
+        memcpy(out, data, count);
+        out += count;
+
+        if (checksum != CHECKSUM_NONE)
+            out = put_little_endian(out, sum, RECORD_CHECKSUM_SIZE);
+        break;
+    }
+
+    return out;
+}
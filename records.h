@@ -0,0 +1,68 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: records.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include "dumps.h"                      // Measure for data types
+#ifndef __RECORDS_H__
+#define __RECORDS_H__
+
+// Output kinds
+#define OUTPUT_TEXT                     0           // Human readable lines
+#define OUTPUT_JSON                     1           // One JSON object per line (NDJSON)
+#define OUTPUT_CSV                      2           // Comma separated values with header
+#define OUTPUT_BINARY                   3           // Length-prefixed binary records
+
+// Data encodings of JSON and CSV records
+#define ENCODING_HEX                    0           // Two lowercase hexadecimal digits per byte
+#define ENCODING_BASE64                 1           // Base64 with padding
+
+// Output names (as given on command line)
+#define OUTPUT_NAME_JSON                "json"
+#define OUTPUT_NAME_CSV                 "csv"
+#define OUTPUT_NAME_BINARY              "bin"
+#define ENCODING_NAME_HEX               "hex"
+#define ENCODING_NAME_BASE64            "base64"
+
+// Binary record layout (all numbers little endian)
+#define RECORD_OFFSET_SIZE              8           // Offset of record data
+#define RECORD_LENGTH_SIZE              4           // Number of data bytes
+#define RECORD_CHECKSUM_SIZE            8           // Checksum after data (only with a checksum)
+
+// Declare functions
+int record_parse(
+    const char* string,
+    int* encoding
+);      // Get output kind and encoding from specification (OUTPUT_TEXT if unknown)
+void record_prepare(
+    void
+);      // Prepare tables of serializer (before any worker thread starts)
+void record_start(
+    FILE* out,
+    int output,
+    int checksum
+);      // Prepare output stream and write CSV header
+char* record_put(
+    char* out,
+    int output,
+    int encoding,
+    uqword_t offset,
+    const ubyte_t* data,
+    size_t count,
+    int checksum,
+    uqword_t sum
+);      // Serialize single record, returns end of serialized data
+
+#endif
@@ -2,7 +2,7 @@
 // Microsoft Visual C++ generated include file.
 // Used by resources.rc
 
-// Dal vchoz hodnoty pro nov objekty
+// Další výchozí hodnoty pro nové objekty
 // 
 #ifdef APSTUDIO_INVOKED
 #ifndef APSTUDIO_READONLY_SYMBOLS
@@ -0,0 +1,327 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: reuse.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <windows.h>
+
+// Local definitions
+#include "reuse.h"
+#include "dumps.h"
+#include "records.h"
+#include "checksum.h"
+#include "info.h"
+
+// Longest path of dump file and its sidecar
+#define REUSE_MAX_PATH                  4096
+
+// Probe data: ASCII, control bytes, bytes above 0x7f and UTF-8 sequences
+static const ubyte_t probe_data[] = "\xc3\xa9Hex09 \x00\x01\x7f\x80\xff\xe2\x82\xac\n";
+
+// Render single dump line - static function
+static char* render_line(const dump_format_t* format, const dump_options_t* options, char* out, size_t ndigits, uqword_t position, const ubyte_t* data, size_t count) {
+    if (options->output != OUTPUT_TEXT)
+        // Structured record (with its own line ending)
+        return record_put(out, options->output, options->encoding, position, data, count, CHECKSUM_NONE, 0);
+
+    // Display line with its line ending
+    out = dump_render_line(format, out, ndigits, position, data, count, options->width);
+    memcpy(out, REUSE_LINE_END, sizeof(REUSE_LINE_END) - 1);
+    return out + sizeof(REUSE_LINE_END) - 1;
+}
+
+// Get hash of a full and a partial line rendered by the display
+uqword_t reuse_probe(const dump_format_t* format, const dump_options_t* options, size_t ndigits) {
+    ubyte_t data[DUMP_MAX_LINE_WIDTH];
+    char text[2 * DUMP_MAX_LINE_CHARS];
+
+    for (size_t i = 0; i < options->width; ++i)
+        data[i] = probe_data[i % (sizeof(probe_data) - 1)];
+
+    // Any change of display, width or output changes the rendered text
+    char* out = render_line(format, options, text, ndigits, 0, data, options->width);
+    if (options->width > 1)
+        out = render_line(format, options, out, ndigits, options->width, data, options->width / 2);
+
+    return checksum_once(CHECKSUM_XXH64, (const unsigned char*)text, out - text);
+}
+
+// Load blocks of previous dump if it was made the same way - static function
+static reuse_block_t* load_sidecar(const char* path, const reuse_header_t* expected, reuse_header_t* header) {
+    FILE* sidecar = fopen(path, "rb");
+    if (!sidecar)
+        return NULL;
+
+    if (fread(header, sizeof(reuse_header_t), 1, sidecar) != 1
+        || memcmp(header->magic, expected->magic, sizeof(header->magic)) != 0
+        || header->probe != expected->probe
+        || header->offset != expected->offset
+        || header->ndigits != expected->ndigits
+        || header->block_size != expected->block_size
+        || header->block_count == 0) {
+        // Not a sidecar or made with different display options
+        fclose(sidecar);
+        return NULL;
+    }
+
+    reuse_block_t* blocks = malloc((size_t)header->block_count * sizeof(reuse_block_t));
+    if (blocks && fread(blocks, sizeof(reuse_block_t), (size_t)header->block_count, sidecar) != header->block_count) {
+        // Truncated sidecar
+        free(blocks);
+        blocks = NULL;
+    }
+
+    fclose(sidecar);
+    return blocks;
+}
+
+// Open previous dump if it's the one described by sidecar - static function
+static FILE* open_previous(const char* path, const reuse_header_t* header) {
+    FILE* previous = fopen(path, "rb");
+    if (!previous)
+        return NULL;
+
+    // Dump edited or replaced since cannot be copied from
+    _fseeki64(previous, 0, SEEK_END);
+    if ((uqword_t)_ftelli64(previous) != header->dump_size) {
+        fclose(previous);
+        return NULL;
+    }
+
+    return previous;
+}
+
+// Copy rendered block from previous dump - static function
+static bool copy_block(FILE* previous, FILE* out, const reuse_block_t* block, char* buffer, bool* read_failed) {
+    _fseeki64(previous, (long long)block->dump_offset, SEEK_SET);
+
+    for (uqword_t left = block->dump_length; left > 0;) {
+        size_t count = (left < REUSE_OUTPUT_SIZE) ? (size_t)left : REUSE_OUTPUT_SIZE;
+
+        if (fread(buffer, 1, count, previous) < count) {
+            // Previous dump became shorter meanwhile
+            *read_failed = true;
+            return false;
+        }
+        if (fwrite(buffer, 1, count, out) < count)
+            return false;
+
+        left -= count;
+    }
+
+    return true;
+}
+
+// Render block of input data - static function
+static bool render_block(FILE* out, const dump_format_t* format, const dump_options_t* options, size_t ndigits, char* buffer, uqword_t begin, const ubyte_t* data, size_t count, uqword_t* length) {
+    char* end = buffer;
+    *length = 0;
+
+    for (size_t i = 0; i < count; i += options->width) {
+        size_t line_count = (count - i < options->width) ? count - i : options->width;
+        end = render_line(format, options, end, ndigits, begin + i, data + i, line_count);
+
+        if (REUSE_OUTPUT_SIZE - (size_t)(end - buffer) < DUMP_MAX_LINE_CHARS || i + line_count >= count) {
+            // Write out full buffer and the end of block
+            size_t written = end - buffer;
+            if (fwrite(buffer, 1, written, out) < written)
+                return false;
+
+            *length += written;
+            end = buffer;
+        }
+    }
+
+    return true;
+}
+
+// Dump range of a file into dump file, copying blocks unchanged since the previous dump
+int reuse_dump(
+    FILE* file,
+    const char* target,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    char sidecar_path[REUSE_MAX_PATH], dump_temp[REUSE_MAX_PATH], sidecar_temp[REUSE_MAX_PATH];
+    int written = snprintf(sidecar_path, sizeof(sidecar_path), "%s%s", target, REUSE_SIDECAR_EXTENSION);
+    snprintf(dump_temp, sizeof(dump_temp), "%s%s", target, REUSE_TEMP_EXTENSION);
+    snprintf(sidecar_temp, sizeof(sidecar_temp), "%s%s%s", target, REUSE_SIDECAR_EXTENSION, REUSE_TEMP_EXTENSION);
+
+    if (written < 0 || (size_t)written + sizeof(REUSE_TEMP_EXTENSION) > sizeof(sidecar_temp)) {
+        // Sidecar path would be too long
+        errno = ENAMETOOLONG;
+        print_file_error("Output file couldn\'t be created");
+
+        return ENAMETOOLONG;
+    }
+
+    // Tables of renderers are used by probe already
+    dump_prepare();
+    record_prepare();
+
+    // Layout of the new dump
+    reuse_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, REUSE_MAGIC, sizeof(header.magic));
+    size_t ndigits = get_offset_digits(endoffset);
+    size_t block_size = REUSE_BLOCK_SIZE - REUSE_BLOCK_SIZE % options->width;
+    size_t block_count = (endoffset - offset + block_size - 1) / block_size;
+    header.probe = reuse_probe(format, options, ndigits);
+    header.offset = offset;
+    header.ndigits = ndigits;
+    header.block_size = block_size;
+    header.block_count = block_count;
+
+    // Previous dump is used only if its sidecar matches and it's still the same size
+    reuse_header_t previous_header;
+    reuse_block_t* previous_blocks = load_sidecar(sidecar_path, &header, &previous_header);
+    FILE* previous = (previous_blocks) ? open_previous(target, &previous_header) : NULL;
+    size_t previous_count = (previous) ? (size_t)previous_header.block_count : 0;
+
+    reuse_block_t* blocks = malloc(((block_count > 0) ? block_count : 1) * sizeof(reuse_block_t));
+    ubyte_t* data = malloc(block_size);
+    char* buffer = malloc(REUSE_OUTPUT_SIZE);
+    FILE* out = NULL;
+
+    if (!blocks || !data || !buffer) {
+        // Not enough memory for buffers
+        if (previous)
+            fclose(previous);
+        free(previous_blocks);
+        free(blocks);
+        free(data);
+        free(buffer);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    // New dump is written aside, the previous one is read meanwhile
+    out = fopen(dump_temp, "wb");
+    if (!out) {
+        // Output file couldn't be created
+        int error = errno;
+        if (previous)
+            fclose(previous);
+        free(previous_blocks);
+        free(blocks);
+        free(data);
+        free(buffer);
+        errno = error;
+        print_file_error("Output file couldn\'t be created");
+
+        return error;
+    }
+
+    if (options->output != OUTPUT_TEXT)
+        record_start(out, options->output, CHECKSUM_NONE);
+
+    uqword_t dump_offset = (uqword_t)_ftelli64(out);
+    size_t reused = 0;
+    bool failed = false, read_failed = false;
+
+    for (size_t i = 0; i < block_count && !failed; ++i) {
+        // Hash every block, render only blocks that changed
+        size_t begin = offset + i * block_size;
+        size_t count = (endoffset - begin < block_size) ? endoffset - begin : block_size;
+
+        if (fread(data, BYTE_SIZE, count, file) < count) {
+            // An error occured while reading file
+            failed = read_failed = true;
+            break;
+        }
+
+        blocks[i].hash = checksum_once(CHECKSUM_XXH64, data, count);
+        blocks[i].count = count;
+        blocks[i].dump_offset = dump_offset;
+
+        if (i < previous_count && previous_blocks[i].hash == blocks[i].hash && previous_blocks[i].count == count) {
+            // Unchanged block is copied as it was rendered
+            blocks[i].dump_length = previous_blocks[i].dump_length;
+            failed = !copy_block(previous, out, &previous_blocks[i], buffer, &read_failed);
+            ++reused;
+        }
+        else
+            failed = !render_block(out, format, options, ndigits, buffer, begin, data, count, &blocks[i].dump_length);
+
+        dump_offset += blocks[i].dump_length;
+        *position += count;
+    }
+
+    if (!failed && options->output == OUTPUT_TEXT) {
+        // Ending offset
+        print_offset(out, ndigits, endoffset);
+        fputs(REUSE_LINE_END, out);
+    }
+
+    header.dump_size = (uqword_t)_ftelli64(out);
+    int error = errno;
+    if (fclose(out) != 0 && !failed) {
+        // Write errors (such as full disk) show up when the output is closed
+        error = errno;
+        failed = true;
+    }
+
+    // Tidy up
+    if (previous)
+        fclose(previous);
+    free(previous_blocks);
+    free(data);
+    free(buffer);
+
+    if (!failed) {
+        // Sidecar of the new dump
+        FILE* sidecar = fopen(sidecar_temp, "wb");
+        failed = !sidecar
+            || fwrite(&header, sizeof(header), 1, sidecar) != 1
+            || fwrite(blocks, sizeof(reuse_block_t), block_count, sidecar) != block_count;
+        error = errno;
+        if (sidecar && fclose(sidecar) != 0 && !failed) {
+            error = errno;
+            failed = true;
+        }
+    }
+    free(blocks);
+
+    if (failed) {
+        // Previous dump and sidecar stay as they were
+        remove(dump_temp);
+        remove(sidecar_temp);
+        errno = (error != 0) ? error : EIO;
+        print_file_error((read_failed) ? "An error occured while file contents output" : "An error occured while writing output file");
+
+        return errno;
+    }
+
+    // New dump and sidecar replace the previous ones (no sidecar is left describing other dump)
+    remove(sidecar_path);
+    if (!MoveFileExA(dump_temp, target, MOVEFILE_REPLACE_EXISTING) || !MoveFileExA(sidecar_temp, sidecar_path, MOVEFILE_REPLACE_EXISTING)) {
+        remove(sidecar_temp);
+        errno = EACCES;
+        print_file_error("Output file couldn\'t be replaced");
+
+        return EACCES;
+    }
+
+    fprintf(stderr, "%llu of %llu blocks reused from previous dump\n", (unsigned long long)reused, (unsigned long long)block_count);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: reuse.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include "dumps.h"                      // Measure for dump format and options
+#ifndef __REUSE_H__
+#define __REUSE_H__
+
+// Define constants
+#define REUSE_BLOCK_SIZE                1048576     // Input bytes hashed as one block (rounded down to whole lines)
+#define REUSE_OUTPUT_SIZE               1048576     // Output bytes buffered before writing
+#define REUSE_MAGIC                     "HDXIDX01"  // First bytes of sidecar file
+#define REUSE_SIDECAR_EXTENSION         ".idx"      // Sidecar file is named after the dump
+#define REUSE_TEMP_EXTENSION            ".tmp"      // New dump and sidecar replace the old ones when complete
+#define REUSE_LINE_END                  "\r\n"      // Line ending of dump file (same as redirected console output)
+
+// Sidecar file header
+typedef struct reuse_header {
+    char magic[8];                      // REUSE_MAGIC
+    uqword_t probe;                     // Hash of probe lines rendered by the display (changes with any display option)
+    uqword_t offset;                    // Initial offset
+    uqword_t ndigits;                   // Offset digits
+    uqword_t block_size;                // Input bytes of a block
+    uqword_t block_count;               // Number of blocks
+    uqword_t dump_size;                 // Size of dump file
+} reuse_header_t;
+
+// Sidecar file entry of one block
+typedef struct reuse_block {
+    uqword_t hash;                      // xxHash64 of block data
+    uqword_t count;                     // Input bytes of block
+    uqword_t dump_offset;               // Offset of rendered block in dump file
+    uqword_t dump_length;               // Length of rendered block
+} reuse_block_t;
+
+// Declare functions
+uqword_t reuse_probe(
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t ndigits
+);      // Get hash of a full and a partial line rendered by the display (changes with any display option)
+int reuse_dump(
+    FILE* file,
+    const char* target,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+);      // Dump range of a file into dump file, copying blocks unchanged since the previous dump
+
+#endif
@@ -0,0 +1,393 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: scan.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// Local definitions
+#include "scan.h"
+#include "dumps.h"
+#include "records.h"
+#include "checksum.h"
+#include "device.h"
+#include "info.h"
+
+// Check bzip2 header before block magic - static function
+static bool check_bzip2(const ubyte_t* start, size_t count) {
+    return memcmp(start, "BZh", 3) == 0 && start[3] >= '1' && start[3] <= '9';
+}
+
+// Check DOS header before DOS stub message - static function
+static bool check_dos_header(const ubyte_t* start, size_t count) {
+    return start[0] == 'M' && start[1] == 'Z';
+}
+
+// Check two DER sequences of long length before certificate version - static function
+static bool check_certificate(const ubyte_t* start, size_t count) {
+    return start[0] == 0x30 && start[1] == 0x82 && start[4] == 0x30 && start[5] == 0x82;
+}
+
+// Define signature with its length taken from the magic literal
+#define SIGNATURE(name, magic, adjust, check)   { name, magic, sizeof(magic) - 1, adjust, check }
+
+// Built-in signatures (a structure may begin before its magic)
+static const scan_signature_t signatures[] = {
+    SIGNATURE("gzip compressed data",                   "\x1f\x8b\x08",                         0,      NULL),
+    SIGNATURE("bzip2 compressed data",                  "1AY&SY",                               4,      check_bzip2),
+    SIGNATURE("xz compressed data",                     "\xfd" "7zXZ\x00",                      0,      NULL),
+    SIGNATURE("7-zip archive",                          "7z\xbc\xaf\x27\x1c",                   0,      NULL),
+    SIGNATURE("Zstandard compressed data",              "\x28\xb5\x2f\xfd",                     0,      NULL),
+    SIGNATURE("LZ4 compressed data",                    "\x04\x22\x4d\x18",                     0,      NULL),
+    SIGNATURE("Zip archive entry",                      "PK\x03\x04",                           0,      NULL),
+    SIGNATURE("Zip archive end of central directory",   "PK\x05\x06",                           0,      NULL),
+    SIGNATURE("RAR archive",                            "Rar!\x1a\x07",                         0,      NULL),
+    SIGNATURE("POSIX tar archive",                      "ustar",                                257,    NULL),
+    SIGNATURE("cpio archive",                           "070701",                               0,      NULL),
+    SIGNATURE("cpio archive with checksums",            "070702",                               0,      NULL),
+    SIGNATURE("Microsoft cabinet archive",              "MSCF\x00\x00\x00\x00",                 0,      NULL),
+    SIGNATURE("ELF 32-bit LSB",                         "\x7f" "ELF\x01\x01\x01",               0,      NULL),
+    SIGNATURE("ELF 64-bit LSB",                         "\x7f" "ELF\x02\x01\x01",               0,      NULL),
+    SIGNATURE("ELF 32-bit MSB",                         "\x7f" "ELF\x01\x02\x01",               0,      NULL),
+    SIGNATURE("ELF 64-bit MSB",                         "\x7f" "ELF\x02\x02\x01",               0,      NULL),
+    SIGNATURE("PE executable",                          "This program cannot be run in DOS mode", 0x4e, check_dos_header),
+    SIGNATURE("Mach-O 32-bit",                          "\xce\xfa\xed\xfe",                     0,      NULL),
+    SIGNATURE("Mach-O 64-bit",                          "\xcf\xfa\xed\xfe",                     0,      NULL),
+    SIGNATURE("Java class or Mach-O universal binary",  "\xca\xfe\xba\xbe",                     0,      NULL),
+    SIGNATURE("Squashfs filesystem, little endian",     "hsqs",                                 0,      NULL),
+    SIGNATURE("Squashfs filesystem, big endian",        "sqsh",                                 0,      NULL),
+    SIGNATURE("CramFS filesystem",                      "\x45\x3d\xcd\x28",                     0,      NULL),
+    SIGNATURE("UBI erase count header",                 "UBI#",                                 0,      NULL),
+    SIGNATURE("ISO 9660 filesystem",                    "\x01" "CD001\x01",                     0x8000, NULL),
+    SIGNATURE("NTFS boot sector",                       "\xeb\x52\x90" "NTFS    ",              0,      NULL),
+    SIGNATURE("U-Boot image",                           "\x27\x05\x19\x56",                     0,      NULL),
+    SIGNATURE("Flattened device tree",                  "\xd0\x0d\xfe\xed",                     0,      NULL),
+    SIGNATURE("PNG image",                              "\x89PNG\x0d\x0a\x1a\x0a",              0,      NULL),
+    SIGNATURE("JPEG image (JFIF)",                      "\xff\xd8\xff\xe0",                     0,      NULL),
+    SIGNATURE("JPEG image (Exif)",                      "\xff\xd8\xff\xe1",                     0,      NULL),
+    SIGNATURE("GIF image",                              "GIF87a",                               0,      NULL),
+    SIGNATURE("GIF image",                              "GIF89a",                               0,      NULL),
+    SIGNATURE("PDF document",                           "%PDF-",                                0,      NULL),
+    SIGNATURE("SQLite database",                        "SQLite format 3\x00",                  0,      NULL),
+    SIGNATURE("DER certificate",                        "\xa0\x03\x02\x01\x02",                 8,      check_certificate),
+    SIGNATURE("PEM armored data",                       "-----BEGIN ",                          0,      NULL),
+};
+
+// Number of built-in signatures
+#define SIGNATURE_COUNT                 (sizeof(signatures) / sizeof(signatures[0]))
+
+// Get value of hexadecimal digit (-1 if it isn't one) - static function
+static int hex_value(char digit) {
+    if (digit >= '0' && digit <= '9')
+        return digit - '0';
+    if (digit >= 'a' && digit <= 'f')
+        return digit - 'a' + 10;
+    if (digit >= 'A' && digit <= 'F')
+        return digit - 'A' + 10;
+
+    return -1;
+}
+
+// Get user pattern from specification (hexadecimal bytes, optionally followed by a colon and a name)
+bool scan_parse(const char* string, scan_pattern_t* pattern) {
+    const char* colon = strchr(string, ':');
+    size_t digits = (colon) ? (size_t)(colon - string) : strlen(string);
+
+    if (digits == 0 || digits % 2 != 0 || digits / 2 > SCAN_MAX_PATTERN || (colon && colon[1] == 0))
+        // Whole bytes only, at most SCAN_MAX_PATTERN of them, name can't be empty
+        return false;
+
+    for (size_t i = 0; i < digits; i += 2) {
+        int high = hex_value(string[i]);
+        int low = hex_value(string[i + 1]);
+        if (high < 0 || low < 0)
+            return false;       // Not a hexadecimal digit
+
+        pattern->magic[i / 2] = (ubyte_t)(high * 16 + low);
+    }
+
+    pattern->name = (colon) ? colon + 1 : SCAN_USER_NAME;
+    pattern->length = digits / 2;
+    pattern->adjust = 0;
+    pattern->check = NULL;
+
+    return true;
+}
+
+// Release automaton - static function
+static void automaton_free(scan_automaton_t* automaton) {
+    free(automaton->delta);
+    free(automaton->match);
+    free(automaton->link);
+}
+
+// Build automaton of all patterns - static function
+static bool automaton_build(scan_automaton_t* automaton, const scan_pattern_t* patterns, size_t count) {
+    // Trie of all patterns is turned into a complete automaton, missing transitions
+    // of every state are the transitions of its longest proper suffix (failure state)
+    size_t capacity = 1;
+    for (size_t i = 0; i < count; ++i)
+        capacity += patterns[i].length;
+
+    automaton->patterns = patterns;
+    automaton->state_count = 1;
+    automaton->delta = calloc(capacity * SCAN_ALPHABET, sizeof(unsigned int));
+    automaton->match = malloc(capacity * sizeof(int));
+    automaton->link = calloc(capacity, sizeof(unsigned int));
+    unsigned int* fail = calloc(capacity, sizeof(unsigned int));
+    unsigned int* queue = malloc(capacity * sizeof(unsigned int));
+
+    if (!automaton->delta || !automaton->match || !automaton->link || !fail || !queue) {
+        // Not enough memory for automaton
+        automaton_free(automaton);
+        free(fail);
+        free(queue);
+
+        return false;
+    }
+
+    for (size_t s = 0; s < capacity; ++s)
+        automaton->match[s] = SCAN_NO_PATTERN;
+
+    for (size_t i = 0; i < count; ++i) {
+        // Add pattern to trie (transition to root means there is none yet)
+        unsigned int state = SCAN_ROOT;
+        for (size_t j = 0; j < patterns[i].length; ++j) {
+            unsigned int* next = &automaton->delta[state * SCAN_ALPHABET + patterns[i].magic[j]];
+            if (*next == SCAN_ROOT)
+                *next = (unsigned int)automaton->state_count++;
+            state = *next;
+        }
+
+        if (automaton->match[state] == SCAN_NO_PATTERN)
+            automaton->match[state] = (int)i;       // Same pattern stated again is reported once
+    }
+
+    // States in breadth-first order, failure states are always closer to root
+    size_t head = 0, tail = 0;
+    for (unsigned int c = 0; c < SCAN_ALPHABET; ++c) {
+        if (automaton->delta[c] != SCAN_ROOT)
+            queue[tail++] = automaton->delta[c];
+    }
+
+    while (head < tail) {
+        unsigned int state = queue[head++];
+        unsigned int* row = &automaton->delta[state * SCAN_ALPHABET];
+        const unsigned int* fail_row = &automaton->delta[fail[state] * SCAN_ALPHABET];
+
+        for (unsigned int c = 0; c < SCAN_ALPHABET; ++c) {
+            if (row[c] == SCAN_ROOT) {
+                // Missing transition continues from failure state
+                row[c] = fail_row[c];
+                continue;
+            }
+
+            // Child state fails to where failure state goes on the same byte
+            unsigned int child = row[c];
+            fail[child] = fail_row[c];
+            automaton->link[child] = (automaton->match[fail[child]] != SCAN_NO_PATTERN) ? fail[child] : automaton->link[fail[child]];
+            queue[tail++] = child;
+        }
+    }
+
+    for (unsigned int c = 0; c < SCAN_ALPHABET; ++c)
+        automaton->starts[c] = automaton->delta[c] != SCAN_ROOT;
+
+    // Pairs of bytes patterns start with (single byte pattern goes with any byte)
+    memset(automaton->pairs, 0, sizeof(automaton->pairs));
+    for (size_t i = 0; i < count; ++i) {
+        for (unsigned int c = 0; c < SCAN_ALPHABET; ++c) {
+            unsigned int pair = patterns[i].magic[0] | (((patterns[i].length > 1) ? patterns[i].magic[1] : c) << 8);
+            automaton->pairs[pair >> 3] |= (ubyte_t)(1 << (pair & 7));
+        }
+    }
+
+    // Transitions to states where some pattern ends are flagged, so that scanning checks a single bit
+    for (size_t i = 0; i < automaton->state_count * SCAN_ALPHABET; ++i) {
+        unsigned int target = automaton->delta[i];
+        if (automaton->match[target] != SCAN_NO_PATTERN || automaton->link[target] != SCAN_ROOT)
+            automaton->delta[i] |= SCAN_OUTPUT_FLAG;
+    }
+
+    free(fail);
+    free(queue);
+
+    return true;
+}
+
+// Print offset and type of every signature found in a single pass, optionally with a canonical window
+int scan_file(
+    FILE* file,
+    const scan_pattern_t* user,
+    size_t user_count,
+    size_t window,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+) {
+    // Format:
+    // "%07x" or greater for offset of each structure
+    // 2 spaces
+    // Structure type
+    // Canonical dump of <window> bytes from the offset (if requested)
+
+    int retcode = 0;
+    scan_automaton_t automaton;
+    size_t count = SIGNATURE_COUNT + user_count;
+    scan_pattern_t* patterns = malloc(count * sizeof(scan_pattern_t));
+    ubyte_t* buffer = malloc(SCAN_HISTORY + options->chunk_size);
+
+    if (patterns) {
+        // Built-in signatures first, then user patterns
+        for (size_t i = 0; i < SIGNATURE_COUNT; ++i) {
+            patterns[i].name = signatures[i].name;
+            memcpy(patterns[i].magic, signatures[i].magic, signatures[i].length);
+            patterns[i].length = signatures[i].length;
+            patterns[i].adjust = signatures[i].adjust;
+            patterns[i].check = signatures[i].check;
+        }
+        memcpy(patterns + SIGNATURE_COUNT, user, user_count * sizeof(scan_pattern_t));
+    }
+
+    if (!patterns || !buffer || !automaton_build(&automaton, patterns, count)) {
+        // Not enough memory for buffers
+        free(patterns);
+        free(buffer);
+        print_error_memory("Out of memory");
+
+        return ENOMEM;
+    }
+
+    // Windows are displayed as lines of the canonical display
+    dump_options_t window_options = *options;
+    window_options.checksum = CHECKSUM_NONE;
+    window_options.output = OUTPUT_TEXT;
+    window_options.dedup = false;
+
+    size_t ndigits = get_offset_digits(endoffset);
+    ubyte_t* data = buffer + SCAN_HISTORY;      // Chunk follows the last bytes of previous one
+    size_t history = 0;                         // Bytes of previous chunk in front of current one
+    unsigned int state = SCAN_ROOT;
+
+    while (*position < endoffset && retcode == 0) {
+        // Read next chunk of the range
+        size_t begin = *position;
+        size_t length = (endoffset - begin < options->chunk_size) ? endoffset - begin : options->chunk_size;
+        size_t successfully_read = fread(data, BYTE_SIZE, length, file);
+
+        for (size_t i = 0; i < successfully_read; ++i) {
+            if (state == SCAN_ROOT) {
+                // Without a partial match, positions where no pattern can start are skipped
+                // by pairs of bytes (no dependency between positions, rarely a candidate),
+                // eight positions are tested before a branch is taken
+                for (; i + SCAN_PAIR_GROUP < successfully_read; i += SCAN_PAIR_GROUP) {
+                    unsigned int found = 0;
+                    for (size_t j = i; j < i + SCAN_PAIR_GROUP; ++j) {
+                        unsigned int pair = data[j] | (data[j + 1] << 8);
+                        found |= automaton.pairs[pair >> 3] & (1 << (pair & 7));
+                    }
+                    if (found)
+                        break;
+                }
+                for (; i + 1 < successfully_read; ++i) {
+                    unsigned int pair = data[i] | (data[i + 1] << 8);
+                    if (automaton.pairs[pair >> 3] & (1 << (pair & 7)))
+                        break;
+                }
+                if (i + 1 == successfully_read && !automaton.starts[data[i]])
+                    break;      // Last byte of chunk starts no pattern either
+            }
+
+            // One transition per byte whatever the number of patterns
+            unsigned int next = automaton.delta[state * SCAN_ALPHABET + data[i]];
+            state = next & SCAN_STATE_MASK;
+            if (!(next & SCAN_OUTPUT_FLAG))
+                continue;
+
+            for (unsigned int s = state; s != SCAN_ROOT; s = automaton.link[s]) {
+                // Every pattern ending here (longest first)
+                if (automaton.match[s] == SCAN_NO_PATTERN)
+                    continue;
+
+                const scan_pattern_t* pattern = &patterns[automaton.match[s]];
+                size_t end = begin + i + 1;
+                size_t reach = pattern->adjust + pattern->length;
+                if (end - offset < pattern->length || end < reach)
+                    continue;       // Pattern started before the range or structure before the file
+
+                if (pattern->check) {
+                    // Structure beginning must still be in the buffer
+                    if (reach > i + 1 + history)
+                        continue;
+                    if (!pattern->check(data + i + 1 - reach, reach))
+                        continue;
+                }
+
+                size_t start = end - reach;
+                print_offset(stdout, ndigits, start);
+                fprintf(stdout, SCAN_FORMAT, pattern->name);
+
+                if (window > 0) {
+                    // Canonical window is read aside, then the scan goes on where it was
+                    size_t window_end = (endoffset - start < window) ? endoffset : start + window;
+                    size_t window_position = start;
+
+                    input_seek(file, options->alignment, start);
+                    retcode = dump_stream(file, stdout, &format_canonical, &window_options, start, &window_position, window_end);
+                    input_seek(file, options->alignment, begin + successfully_read);
+
+                    if (retcode != 0) {
+                        // An error occured while reading file
+                        errno = retcode;
+                        print_file_error("An error occured while file contents output");
+                        break;
+                    }
+                }
+            }
+
+            if (retcode != 0)
+                break;
+        }
+
+        // Get new position from number of scanned bytes
+        *position += successfully_read;
+
+        if (retcode == 0 && successfully_read < length) {
+            // An error occured while reading file
+            retcode = (errno != 0) ? errno : EIO;
+            print_file_error("An error occured while file contents output");
+        }
+
+        // Keep the last bytes for checks of structures beginning in this chunk
+        history = (successfully_read < SCAN_HISTORY) ? successfully_read : SCAN_HISTORY;
+        memmove(data - history, data + successfully_read - history, history);
+    }
+
+    if (retcode == 0) {
+        // Ending offset
+        print_offset(stdout, ndigits, *position);
+        fputs("\n", stdout);
+    }
+
+    // Tidy up
+    automaton_free(&automaton);
+    free(patterns);
+    free(buffer);
+
+    return retcode;
+}
@@ -0,0 +1,90 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: scan.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdio.h>                      // Measure for file descriptor
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for dump format and options
+#ifndef __SCAN_H__
+#define __SCAN_H__
+
+// Define constants
+#define SCAN_MAX_USER                   256         // Most user patterns stated on command line
+#define SCAN_MAX_PATTERN                64          // Longest pattern in bytes
+#define SCAN_HISTORY                    128         // Bytes before a match kept for signature checks
+#define SCAN_ALPHABET                   256         // Transitions of every automaton state
+#define SCAN_ROOT                       0           // Initial state of automaton
+#define SCAN_PAIRS                      65536       // Pairs of bytes filtered before the automaton is followed
+#define SCAN_PAIR_GROUP                 8           // Positions filtered at once
+#define SCAN_OUTPUT_FLAG                0x80000000u // Transition leads to a state where some pattern ends
+#define SCAN_STATE_MASK                 0x7fffffffu // State number of transition
+#define SCAN_NO_PATTERN                 -1          // State isn't the end of any pattern
+#define SCAN_USER_NAME                  "user pattern"  // Name of user pattern stated without one
+
+// Output format
+#define SCAN_FORMAT                     "  %s\n"    // After offset of each hit
+
+// Signature check of bytes from the structure beginning up to the end of the match
+typedef bool (*scan_check_t)(
+    const ubyte_t* start,
+    size_t count
+);
+
+// Built-in signature
+typedef struct scan_signature {
+    const char* name;                   // Type displayed for each hit
+    const char* magic;                  // Pattern bytes
+    size_t length;                      // Number of pattern bytes
+    size_t adjust;                      // Offset of pattern inside the structure it marks
+    scan_check_t check;                 // Additional check (NULL if pattern is enough)
+} scan_signature_t;
+
+// Pattern matched by the automaton
+typedef struct scan_pattern {
+    const char* name;                   // Type displayed for each hit
+    ubyte_t magic[SCAN_MAX_PATTERN];    // Pattern bytes
+    size_t length;                      // Number of pattern bytes
+    size_t adjust;                      // Offset of pattern inside the structure it marks
+    scan_check_t check;                 // Additional check (NULL if pattern is enough)
+} scan_pattern_t;
+
+// Multi-pattern automaton (Aho-Corasick, every state has all transitions)
+typedef struct scan_automaton {
+    const scan_pattern_t* patterns;     // Matched patterns
+    size_t state_count;                 // Number of states
+    unsigned int* delta;                // Transitions, SCAN_ALPHABET per state (SCAN_OUTPUT_FLAG marks states with hits)
+    int* match;                         // Pattern ending in each state (SCAN_NO_PATTERN if none)
+    unsigned int* link;                 // Nearest shorter suffix state with a pattern (SCAN_ROOT if none)
+    bool starts[SCAN_ALPHABET];         // Bytes leaving root
+    ubyte_t pairs[SCAN_PAIRS / 8];      // Bit of every pair of bytes some pattern can start with (first byte in low bits)
+} scan_automaton_t;
+
+// Declare functions
+bool scan_parse(
+    const char* string,
+    scan_pattern_t* pattern
+);      // Get user pattern from specification (hexadecimal bytes, optionally followed by a colon and a name)
+int scan_file(
+    FILE* file,
+    const scan_pattern_t* user,
+    size_t user_count,
+    size_t window,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset
+);      // Print offset and type of every signature found in a single pass, optionally with a canonical window
+
+#endif
@@ -9,7 +9,7 @@
  * File: switches.h
  * 
  *-------------------------------------------------
- * Made by Marek Polek (Polda18)
+ * Made by Marek Poláček (Polda18)
  **************************************************/
 
 #pragma once
@@ -23,13 +23,17 @@
 // Help switch
 #define SW_HELP                 0x00000001      // -h switch
 
-// Dump switches: -bcCdox
+// Dump switches: -bBcCdox (-B needs 64-bit register)
 #define SW_DUMP_BYTE_OCTAL      0x00000002      // -b switch
 #define SW_DUMP_BYTE_CHAR       0x00000004      // -c switch
 #define SW_DUMP_CANONICAL       0x00000008      // -C switch
 #define SW_DUMP_WORD_DECIMAL    0x00000010      // -d switch
 #define SW_DUMP_WORD_OCTAL      0x00000020      // -o switch
 #define SW_DUMP_WORD_HEX        0x00000040      // -x switch
+#define SW_DUMP_BYTE_BINARY     0x0000000200000000ULL   // -B switch
+
+// All dump switches
+#define SW_DUMP_MASK            0x000000020000007eULL
 
 // File seeking switches -n, -s
 // Undefined flags for these (direct input)
@@ -37,6 +41,67 @@
 // Verbose switch
 #define SW_VERBOSE              0x00000080      // -v switch
 
+// Progress switches
+#define SW_PROGRESS             0x00000100      // -p switch
+#define SW_PROGRESS_FORCE       0x00000200      // -P switch
+
+// Analysis switch
+#define SW_ANALYSIS             0x00000400      // -a switch
+
+// Follow switch
+#define SW_FOLLOW               0x00000800      // -f switch
+
+// Viewer switch
+#define SW_VIEWER               0x00001000      // -V switch
+
+// Sampling switch
+#define SW_SAMPLE               0x00002000      // -S switch
+
+// Structured output switch
+#define SW_OUTPUT               0x00004000      // -O switch
+
+// UTF-8 modifier of character displays
+#define SW_UTF8                 0x00008000      // u after -c or -C
+
+// Batch switch
+#define SW_BATCH                0x00010000      // -D switch
+
+// Positional write switch
+#define SW_WRITE                0x00020000      // -W switch
+
+// Incremental dump switch
+#define SW_REUSE                0x00040000      // -R switch
+
+// Process memory switch
+#define SW_PROCESS              0x00080000      // -M switch
+
+// Explain switch --explain (needs 64-bit register)
+#define SW_EXPLAIN              0x0000000400000000ULL   // --explain switch
+
+// Back-reference switch (needs 64-bit register)
+#define SW_DEDUP                0x0000000800000000ULL   // -g switch
+
+// Strings switch (needs 64-bit register)
+#define SW_STRINGS              0x0000001000000000ULL   // -e switch
+
+// Signature scan switch (needs 64-bit register)
+#define SW_SCAN                 0x0000004000000000ULL   // -m or -y switch
+
+// Archive member switch (needs 64-bit register)
+#define SW_ARCHIVE              0x0000010000000000ULL   // -A switch
+
+// Checkpoint switch (needs 64-bit register)
+#define SW_CHECKPOINT           0x0000020000000000ULL   // -K switch
+
+// C include switch (needs 64-bit register)
+#define SW_INCLUDE              0x0000040000000000ULL   // -i switch
+
+// Workers switch -j, checksum switch -k, width switch -w, type switch -t, sampling switch -S,
+// output switch -O, batch switch -D, write switch -W, incremental dump switch -R, strings switch -e,
+// signature scan window -m, signature pattern -y, archive member -A,
+// checkpointed output -K
+// Undefined flags for these (direct input)
+
 // Invalid switch found
 #define SW_INVALID              0x00100000      // -? switch, where ? is anything but above
 
@@ -52,4 +117,34 @@
 // Offset number in incorrect format
 #define SW_OFFSETFORMAT         0x01000000
 
+// Analysis block size in incorrect format
+#define SW_BLOCKFORMAT          0x02000000
+
+// Number of workers in incorrect format
+#define SW_WORKERSFORMAT        0x04000000
+
+// Checksum specification in incorrect format
+#define SW_CHECKSUMFORMAT       0x08000000
+
+// Line width in incorrect format
+#define SW_WIDTHFORMAT          0x10000000
+
+// Type specification in incorrect format
+#define SW_TYPEFORMAT           0x20000000
+
+// More ranges than can be dumped at once
+#define SW_RANGECOUNT           0x40000000
+
+// Sampling specification in incorrect format
+#define SW_SAMPLEFORMAT         0x80000000
+
+// Output specification in incorrect format (flags from here on need 64-bit register)
+#define SW_OUTPUTFORMAT         0x0000000100000000ULL
+
+// Strings specification in incorrect format
+#define SW_STRINGSFORMAT        0x0000002000000000ULL
+
+// Signature window or pattern in incorrect format
+#define SW_SCANFORMAT           0x0000008000000000ULL
+
 #endif
@@ -0,0 +1,388 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: viewer.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <conio.h>
+#include <windows.h>
+
+// Local definitions
+#include "viewer.h"
+#include "dumps.h"
+#include "info.h"
+
+// Get pointer to mapped file data - static function
+static const ubyte_t* viewer_map(viewer_t* viewer, uqword_t offset, size_t count) {
+    if (viewer->view && offset >= viewer->view_begin && offset + count <= viewer->view_begin + viewer->view_size)
+        // Already in current window
+        return viewer->view + (offset - viewer->view_begin);
+
+    if (viewer->view)
+        // Drop current window
+        UnmapViewOfFile((LPCVOID)viewer->view);
+
+    // New window starts at the nearest allowed boundary before offset
+    uqword_t begin = offset - offset % viewer->granularity;
+    uqword_t size = viewer->size - begin;
+    if (size > VIEWER_WINDOW_SIZE)
+        size = VIEWER_WINDOW_SIZE;
+
+    viewer->view = MapViewOfFile((HANDLE)viewer->mapping, FILE_MAP_READ, (DWORD)(begin >> 32), (DWORD)begin, (SIZE_T)size);
+    viewer->view_begin = begin;
+    viewer->view_size = (viewer->view) ? (size_t)size : 0;
+
+    return (viewer->view) ? viewer->view + (offset - begin) : NULL;
+}
+
+// Get number of lines fitting on screen - static function
+static size_t viewer_lines(void) {
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    size_t rows = 25;   // Default console window height
+
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info))
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+
+    // Last row is reserved for status line
+    if (rows > VIEWER_MAX_ROWS)
+        rows = VIEWER_MAX_ROWS;
+    return (rows > 1) ? rows - 1 : 1;
+}
+
+// Get offset of first line of last page - static function
+static uqword_t viewer_last_top(viewer_t* viewer, size_t lines) {
+    uqword_t page = (uqword_t)lines * viewer->width;
+    uqword_t end = viewer->size + (viewer->width - 1) - (viewer->size + viewer->width - 1) % viewer->width;
+
+    return (end > page) ? end - page : 0;
+}
+
+// Move screen to given offset - static function
+static void viewer_move(viewer_t* viewer, uqword_t top, size_t lines) {
+    uqword_t last = viewer_last_top(viewer, lines);
+
+    // Lines always start at multiples of line width
+    top -= top % viewer->width;
+    viewer->top = (top > last) ? last : top;
+}
+
+// Draw visible lines and status line - static function
+static void viewer_draw(viewer_t* viewer, size_t lines, const char* status) {
+    char* out = viewer->screen;
+
+    memcpy(out, VIEWER_SEQ_HOME, sizeof(VIEWER_SEQ_HOME) - 1);
+    out += sizeof(VIEWER_SEQ_HOME) - 1;
+
+    for (size_t i = 0; i < lines; ++i) {
+        // Only lines on screen are ever rendered
+        uqword_t position = viewer->top + (uqword_t)i * viewer->width;
+
+        if (position < viewer->size) {
+            size_t count = (viewer->size - position < viewer->width) ? (size_t)(viewer->size - position) : viewer->width;
+            const ubyte_t* data = viewer_map(viewer, position, count);
+
+            if (data)
+                out = dump_render_line(viewer->format, out, viewer->ndigits, position, data, count, viewer->width);
+        }
+
+        // Clear rest of previous contents
+        memcpy(out, VIEWER_SEQ_CLEAR_LINE "\n", sizeof(VIEWER_SEQ_CLEAR_LINE "\n") - 1);
+        out += sizeof(VIEWER_SEQ_CLEAR_LINE "\n") - 1;
+    }
+
+    // Status line (without line feed, the screen would scroll otherwise)
+    out += sprintf(out, VIEWER_SEQ_STATUS "%s" VIEWER_SEQ_CLEAR_LINE VIEWER_SEQ_NORMAL, status);
+
+    fwrite(viewer->screen, 1, out - viewer->screen, stdout);
+    fflush(stdout);
+}
+
+// Draw position status line - static function
+static void viewer_draw_position(viewer_t* viewer, size_t lines, const char* message) {
+    char status[VIEWER_MAX_STATUS];
+    double percent = (viewer->size > 0) ? 100.0 * viewer->top / viewer->size : 100.0;
+
+    snprintf(status, sizeof(status), " %0*llx / %0*llx  %5.1f%%  %s",
+        (int)viewer->ndigits, viewer->top, (int)viewer->ndigits, viewer->size, percent,
+        (message) ? message : VIEWER_HELP);
+
+    viewer_draw(viewer, lines, status);
+}
+
+// Read line of text on status line - static function
+static bool viewer_prompt(viewer_t* viewer, size_t lines, const char* prompt, char* buffer, size_t size) {
+    char status[VIEWER_MAX_STATUS];
+    size_t length = 0;
+    buffer[0] = 0;
+
+    for (;;) {
+        // Show what was typed so far
+        snprintf(status, sizeof(status), " %s%s", prompt, buffer);
+        viewer_draw(viewer, lines, status);
+
+        int key = _getch();
+
+        if (key == VIEWER_KEY_ENTER)
+            // Confirmed
+            return length > 0;
+        if (key == VIEWER_KEY_ESCAPE || key == VIEWER_KEY_CTRL_C)
+            // Cancelled
+            return false;
+
+        if (key == VIEWER_KEY_EXTENDED_1 || key == VIEWER_KEY_EXTENDED_2)
+            // Extended keys are ignored
+            _getch();
+        else if (key == VIEWER_KEY_BACKSPACE) {
+            // Remove last character
+            if (length > 0)
+                buffer[--length] = 0;
+        }
+        else if (key >= ASCII_LOWEST && key <= ASCII_HIGHEST && length < size - 1) {
+            // Add printable character
+            buffer[length++] = (char)key;
+            buffer[length] = 0;
+        }
+    }
+}
+
+// Find search pattern - static function
+static bool viewer_search(viewer_t* viewer, uqword_t from, uqword_t* found) {
+    size_t length = viewer->pattern_length;
+    ubyte_t first = (ubyte_t)viewer->pattern[0];
+
+    while (from + length <= viewer->size) {
+        // Search through one window at a time (at least the pattern length is always mapped)
+        const ubyte_t* data = viewer_map(viewer, from, length);
+        if (!data)
+            return false;   // Window couldn't be mapped
+
+        size_t available = (size_t)(viewer->view_begin + viewer->view_size - from);
+        const ubyte_t* end = data + available;
+
+        for (const ubyte_t* c = data; end - c >= (ptrdiff_t)length; ++c) {
+            // Look for the first character, then compare the rest
+            c = memchr(c, first, end - c - length + 1);
+            if (!c)
+                break;
+
+            if (memcmp(c, viewer->pattern, length) == 0) {
+                *found = from + (c - data);
+                return true;
+            }
+        }
+
+        if (viewer->view_begin + viewer->view_size >= viewer->size)
+            // Reached end of file
+            break;
+
+        // Pattern may cross the window boundary
+        from += available - length + 1;
+    }
+
+    return false;
+}
+
+// Search from given offset and move to match - static function
+static const char* viewer_find(viewer_t* viewer, uqword_t from, size_t lines) {
+    viewer_draw_position(viewer, lines, "Searching...");
+
+    uqword_t found;
+    if (!viewer_search(viewer, from, &found))
+        return "Pattern not found";
+
+    viewer->match = found;
+    viewer->has_match = true;
+    viewer_move(viewer, found, lines);
+
+    return "Pattern found";
+}
+
+// Browse file interactively
+int view_file(const char* path, const dump_format_t* format, size_t width, size_t offset) {
+    viewer_t viewer;
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode;
+
+    if (!GetConsoleMode(output, &mode) || !SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING)) {
+        // Screen can only be drawn on a console window
+        print_error("Viewer needs standard output to be a console window");
+
+        return ENOTTY;
+    }
+
+    // Open file separately, mapping needs a system file handle
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)) {
+        // File couldn't be opened for mapping
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        SetConsoleMode(output, mode);
+        print_error("File couldn\'t be opened for viewing");
+
+        return EIO;
+    }
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    viewer.file = file;
+    viewer.size = size.QuadPart;
+    viewer.view = NULL;
+    viewer.view_begin = 0;
+    viewer.view_size = 0;
+    viewer.granularity = info.dwAllocationGranularity;
+    viewer.format = format;
+    viewer.width = width;
+    viewer.ndigits = get_offset_digits(viewer.size);
+    viewer.has_match = false;
+    viewer.pattern_length = 0;
+
+    // Empty file cannot be mapped (there is nothing to map anyway)
+    viewer.mapping = (viewer.size > 0) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    viewer.screen = malloc((VIEWER_MAX_ROWS + 1) * DUMP_MAX_LINE_CHARS + VIEWER_MAX_STATUS);
+
+    if ((viewer.size > 0 && !viewer.mapping) || !viewer.screen) {
+        // Mapping or screen buffer couldn't be created
+        if (viewer.mapping)
+            CloseHandle(viewer.mapping);
+        CloseHandle(file);
+        free(viewer.screen);
+        SetConsoleMode(output, mode);
+        print_error("File couldn\'t be mapped into memory");
+
+        return EIO;
+    }
+
+    dump_prepare();
+
+    // Switch to alternate screen, the original console contents are kept intact
+    fputs(VIEWER_SEQ_ENTER, stdout);
+
+    size_t lines = viewer_lines();
+    const char* message = NULL;
+    bool running = true;
+
+    viewer_move(&viewer, offset, lines);
+
+    while (running) {
+        // Window may be resized any time
+        lines = viewer_lines();
+        viewer_move(&viewer, viewer.top, lines);
+        viewer_draw_position(&viewer, lines, message);
+        message = NULL;
+
+        uqword_t page = (uqword_t)lines * viewer.width;
+        int key = _getch();
+
+        if (key == VIEWER_KEY_EXTENDED_1 || key == VIEWER_KEY_EXTENDED_2) {
+            // Arrows and navigation keys
+            switch (_getch()) {
+            case VIEWER_KEY_UP:
+                viewer_move(&viewer, (viewer.top > viewer.width) ? viewer.top - viewer.width : 0, lines);
+                break;
+            case VIEWER_KEY_DOWN:
+                viewer_move(&viewer, viewer.top + viewer.width, lines);
+                break;
+            case VIEWER_KEY_PAGE_UP:
+                viewer_move(&viewer, (viewer.top > page) ? viewer.top - page : 0, lines);
+                break;
+            case VIEWER_KEY_PAGE_DOWN:
+                viewer_move(&viewer, viewer.top + page, lines);
+                break;
+            case VIEWER_KEY_HOME:
+                viewer_move(&viewer, 0, lines);
+                break;
+            case VIEWER_KEY_END:
+                viewer_move(&viewer, viewer.size, lines);
+                break;
+            }
+            continue;
+        }
+
+        switch (key) {
+        case 'q':
+        case VIEWER_KEY_ESCAPE:
+        case VIEWER_KEY_CTRL_C:
+            // Quit viewer
+            running = false;
+            break;
+        case 'k':
+            // Line up
+            viewer_move(&viewer, (viewer.top > viewer.width) ? viewer.top - viewer.width : 0, lines);
+            break;
+        case 'j':
+        case VIEWER_KEY_ENTER:
+            // Line down
+            viewer_move(&viewer, viewer.top + viewer.width, lines);
+            break;
+        case 'b':
+            // Page up
+            viewer_move(&viewer, (viewer.top > page) ? viewer.top - page : 0, lines);
+            break;
+        case ' ':
+            // Page down
+            viewer_move(&viewer, viewer.top + page, lines);
+            break;
+        case 'g': {
+            // Jump to offset (any line is reachable without reading the data before it)
+            char input[VIEWER_MAX_PATTERN];
+            if (viewer_prompt(&viewer, lines, VIEWER_PROMPT_GOTO, input, sizeof(input))) {
+                char* end;
+                uqword_t target = strtoull(input, &end, 0);
+                if (*end != 0)
+                    message = "Offset must be a decimal, hexadecimal (0x) or octal (0) number";
+                else
+                    viewer_move(&viewer, target, lines);
+            }
+            break;
+        }
+        case '/':
+            // Search for text from current screen
+            if (viewer_prompt(&viewer, lines, VIEWER_PROMPT_SEARCH, viewer.pattern, sizeof(viewer.pattern))) {
+                viewer.pattern_length = strlen(viewer.pattern);
+                message = viewer_find(&viewer, viewer.top, lines);
+            }
+            else
+                viewer.pattern_length = 0;
+            break;
+        case 'n':
+            // Search for next match
+            if (viewer.pattern_length == 0)
+                message = "No search pattern";
+            else
+                message = viewer_find(&viewer, (viewer.has_match) ? viewer.match + 1 : viewer.top, lines);
+            break;
+        }
+    }
+
+    // Restore console
+    fputs(VIEWER_SEQ_LEAVE, stdout);
+    fflush(stdout);
+    SetConsoleMode(output, mode);
+
+    // Tidy up
+    if (viewer.view)
+        UnmapViewOfFile((LPCVOID)viewer.view);
+    if (viewer.mapping)
+        CloseHandle(viewer.mapping);
+    CloseHandle(file);
+    free(viewer.screen);
+
+    return 0;
+}
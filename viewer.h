@@ -0,0 +1,83 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: viewer.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for line formats
+#ifndef __VIEWER_H__
+#define __VIEWER_H__
+
+// Define constants
+#define VIEWER_WINDOW_SIZE              16777216    // Bytes of file mapped at once
+#define VIEWER_MAX_ROWS                 256         // Most lines displayed on screen
+#define VIEWER_MAX_PATTERN              256         // Longest search pattern
+#define VIEWER_MAX_STATUS               512         // Longest status line
+
+// Terminal control sequences
+#define VIEWER_SEQ_ENTER                "\x1b[?1049h\x1b[?25l"  // Alternate screen, hide cursor
+#define VIEWER_SEQ_LEAVE                "\x1b[?25h\x1b[?1049l"  // Show cursor, main screen
+#define VIEWER_SEQ_HOME                 "\x1b[H"                // Cursor to upper left corner
+#define VIEWER_SEQ_CLEAR_LINE           "\x1b[K"                // Clear rest of line
+#define VIEWER_SEQ_STATUS               "\x1b[7m"               // Reverse colors
+#define VIEWER_SEQ_NORMAL               "\x1b[0m"               // Default colors
+
+// Keys (extended keys are preceded by 0 or 0xe0)
+#define VIEWER_KEY_EXTENDED_1           0x00
+#define VIEWER_KEY_EXTENDED_2           0xe0
+#define VIEWER_KEY_UP                   72
+#define VIEWER_KEY_DOWN                 80
+#define VIEWER_KEY_PAGE_UP              73
+#define VIEWER_KEY_PAGE_DOWN            81
+#define VIEWER_KEY_HOME                 71
+#define VIEWER_KEY_END                  79
+#define VIEWER_KEY_ENTER                '\r'
+#define VIEWER_KEY_ESCAPE               0x1b
+#define VIEWER_KEY_BACKSPACE            0x08
+#define VIEWER_KEY_CTRL_C               0x03
+
+// Status line texts
+#define VIEWER_HELP                     "q quit  g goto  / search  n next"
+#define VIEWER_PROMPT_GOTO              "Go to offset: "
+#define VIEWER_PROMPT_SEARCH            "Search text: "
+
+// Viewer state
+typedef struct viewer {
+    void* file;                         // File handle
+    void* mapping;                      // File mapping handle (NULL for empty file)
+    uqword_t size;                      // File size
+    const ubyte_t* view;                // Mapped window of file (NULL if not mapped yet)
+    uqword_t view_begin;                // Offset of mapped window
+    size_t view_size;                   // Bytes in mapped window
+    size_t granularity;                 // Alignment of mapped windows
+    const dump_format_t* format;        // Line format
+    size_t width;                       // Bytes per line
+    size_t ndigits;                     // Offset digits
+    uqword_t top;                       // Offset of first line on screen
+    uqword_t match;                     // Offset of last search match
+    bool has_match;                     // Last search found something
+    char pattern[VIEWER_MAX_PATTERN];   // Search pattern
+    size_t pattern_length;              // Bytes in search pattern
+    char* screen;                       // Screen buffer
+} viewer_t;
+
+// Declare functions
+int view_file(
+    const char* path,
+    const dump_format_t* format,
+    size_t width,
+    size_t offset
+);      // Browse file interactively, starting at given offset
+
+#endif
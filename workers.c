@@ -0,0 +1,79 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: workers.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <process.h>
+#include <windows.h>
+
+// Local definitions
+#include "workers.h"
+
+// Resolve number of workers
+unsigned int get_worker_count(unsigned int requested) {
+    if (requested == 0) {
+        // Use one worker per logical processor
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        requested = info.dwNumberOfProcessors;
+    }
+
+    // Keep the count in bounds
+    if (requested < 1)
+        requested = 1;
+    if (requested > MAX_WORKERS)
+        requested = MAX_WORKERS;
+
+    return requested;
+}
+
+// Start workers
+bool workers_start(
+    workers_t* workers,
+    unsigned int count,
+    worker_routine_t routine,
+    void* contexts,
+    size_t context_size
+) {
+    workers->count = 0;
+
+    for (unsigned int i = 0; i < count && i < MAX_WORKERS; ++i) {
+        // Each worker gets its own context from the array
+        void* context = (char*)contexts + i * context_size;
+        uintptr_t thread = _beginthreadex(NULL, 0, routine, context, 0, NULL);
+
+        if (!thread) {
+            // Thread couldn't be created -> wait for those already running
+            workers_wait(workers);
+            return false;
+        }
+
+        workers->threads[workers->count++] = (void*)thread;
+    }
+
+    return true;
+}
+
+// Wait for workers
+void workers_wait(workers_t* workers) {
+    for (unsigned int i = 0; i < workers->count; ++i) {
+        // Wait for thread to finish and tidy up
+        WaitForSingleObject((HANDLE)workers->threads[i], INFINITE);
+        CloseHandle((HANDLE)workers->threads[i]);
+    }
+
+    workers->count = 0;
+}
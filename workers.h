@@ -0,0 +1,48 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: workers.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdbool.h>                    // Measure for boolean type
+#ifndef __WORKERS_H__
+#define __WORKERS_H__
+
+// Define constants
+#define MAX_WORKERS                     64          // Maximum number of worker threads
+
+// Worker thread routine
+typedef unsigned int (__stdcall *worker_routine_t)(void* context);
+
+// Group of running worker threads
+typedef struct workers {
+    void* threads[MAX_WORKERS];         // Thread handles
+    unsigned int count;                 // Number of running threads
+} workers_t;
+
+// Declare functions
+unsigned int get_worker_count(
+    unsigned int requested
+);      // Resolve number of workers (0 means one per processor)
+bool workers_start(
+    workers_t* workers,
+    unsigned int count,
+    worker_routine_t routine,
+    void* contexts,
+    size_t context_size
+);      // Start workers, each with its own context from the array
+void workers_wait(
+    workers_t* workers
+);      // Wait for all workers to finish
+
+#endif
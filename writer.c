@@ -0,0 +1,250 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: writer.c
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+// Global definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <io.h>
+#include <windows.h>
+
+// Local definitions
+#include "writer.h"
+#include "dumps.h"
+#include "records.h"
+#include "checksum.h"
+#include "workers.h"
+#include "info.h"
+
+// Advance position watched by progress from any worker
+#if defined(_WIN64)
+#define ADVANCE_POSITION(position, count) InterlockedExchangeAdd64((volatile LONG64*)(position), (LONG64)(count))
+#else
+#define ADVANCE_POSITION(position, count) InterlockedExchangeAdd((volatile LONG*)(position), (LONG)(count))
+#endif
+
+// Render single output line - static function
+static char* render_line(const writer_t* writer, char* out, uqword_t position, const ubyte_t* data, size_t count) {
+    if (writer->options->output == OUTPUT_BINARY)
+        // Binary record
+        return record_put(out, OUTPUT_BINARY, ENCODING_HEX, position, data, count, CHECKSUM_NONE, 0);
+
+    // Display line with its line ending
+    out = dump_render_line(writer->format, out, writer->ndigits, position, data, count, writer->options->width);
+    memcpy(out, WRITE_LINE_END, sizeof(WRITE_LINE_END) - 1);
+    return out + sizeof(WRITE_LINE_END) - 1;
+}
+
+// Get output length of a line of given byte count - static function
+static size_t get_line_length(const writer_t* writer, size_t count) {
+    // Length of a line doesn't depend on its data (checked by write_supported)
+    ubyte_t data[DUMP_MAX_LINE_WIDTH] = { 0 };
+    char line[DUMP_MAX_LINE_CHARS];
+
+    return render_line(writer, line, 0, data, count) - line;
+}
+
+// Keep the first error of all workers - static function
+static void set_error(writer_t* writer, long error) {
+    InterlockedCompareExchange(&writer->error, error, 0);
+}
+
+// Read data at given offset - static function
+static bool read_at(HANDLE file, ubyte_t* data, size_t count, uqword_t offset) {
+    OVERLAPPED at = { 0 };
+    at.Offset = (DWORD)offset;
+    at.OffsetHigh = (DWORD)(offset >> 32);
+
+    DWORD done;
+    return ReadFile(file, data, (DWORD)count, &done, &at) && done == count;
+}
+
+// Write data at given offset - static function
+static bool write_at(HANDLE file, const char* data, size_t count, uqword_t offset) {
+    OVERLAPPED at = { 0 };
+    at.Offset = (DWORD)offset;
+    at.OffsetHigh = (DWORD)(offset >> 32);
+
+    DWORD done;
+    return WriteFile(file, data, (DWORD)count, &done, &at) && done == count;
+}
+
+// Worker thread routine - static function
+static unsigned int __stdcall writer_worker(void* context) {
+    writer_t* writer = *(writer_t**)context;
+    size_t width = writer->options->width;
+    size_t lines = writer->chunk_size / width;
+
+    // Every worker reads and writes through its own handles, so that
+    // positioned reads and writes of different workers don't wait for each other
+    ubyte_t* data = malloc(writer->chunk_size);
+    char* text = malloc(lines * writer->line_length + DUMP_MAX_LINE_CHARS);
+    HANDLE input = CreateFileA(writer->path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    HANDLE output = CreateFileA(writer->target, GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (!data || !text)
+        set_error(writer, ENOMEM);
+    else if (input == INVALID_HANDLE_VALUE || output == INVALID_HANDLE_VALUE)
+        set_error(writer, EIO);
+
+    while (writer->error == 0) {
+        // Take next chunk until there is none left
+        size_t index = (size_t)InterlockedIncrement(&writer->next) - 1;
+        if (index >= writer->chunk_count)
+            break;
+
+        size_t begin = writer->offset + index * writer->chunk_size;
+        size_t count = (writer->endoffset - begin < writer->chunk_size) ? writer->endoffset - begin : writer->chunk_size;
+
+        if (!read_at(input, data, count, begin)) {
+            // An error occured while reading file
+            set_error(writer, EIO);
+            break;
+        }
+
+        char* out = text;
+        for (size_t i = 0; i < count && writer->error == 0; i += width) {
+            // Render lines of the chunk, each full line must be exactly as long as computed
+            size_t line_count = (count - i < width) ? count - i : width;
+            char* line = out;
+            out = render_line(writer, out, begin + i, data + i, line_count);
+
+            if (line_count == width && (size_t)(out - line) != writer->line_length)
+                set_error(writer, EINVAL);
+        }
+
+        // Chunk goes right where its lines belong in output file
+        if (writer->error == 0 && !write_at(output, text, out - text, (uqword_t)index * lines * writer->line_length))
+            set_error(writer, EIO);
+
+        ADVANCE_POSITION(writer->position, count);
+    }
+
+    // Tidy up
+    if (input != INVALID_HANDLE_VALUE)
+        CloseHandle(input);
+    if (output != INVALID_HANDLE_VALUE)
+        CloseHandle(output);
+    free(data);
+    free(text);
+
+    return 0;
+}
+
+// Check if lines of given format and options have a fixed length
+bool write_supported(const dump_format_t* format, const dump_options_t* options) {
+    // Checksums, back-references, UTF-8 characters and decimal offsets of JSON
+    // and CSV records make lengths of lines depend on their data
+    return options->checksum == CHECKSUM_NONE
+        && !options->dedup
+        && (options->output == OUTPUT_TEXT || options->output == OUTPUT_BINARY)
+        && format != &format_byte_char_utf8
+        && format != &format_canonical_utf8;
+}
+
+// Dump range of a file into output file
+int write_file(
+    const char* path,
+    const char* target,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset,
+    unsigned int workers
+) {
+    writer_t writer;
+    writer.path = path;
+    writer.target = target;
+    writer.format = format;
+    writer.options = options;
+    writer.ndigits = get_offset_digits(endoffset);
+    writer.offset = offset;
+    writer.endoffset = endoffset;
+    writer.chunk_size = WRITE_CHUNK_SIZE - WRITE_CHUNK_SIZE % options->width;
+    writer.chunk_count = (endoffset - offset + writer.chunk_size - 1) / writer.chunk_size;
+    writer.next = 0;
+    writer.error = 0;
+    writer.position = position;
+
+    // Tables filled on first use are filled before workers start
+    dump_prepare();
+    record_prepare();
+
+    // Every full line has the same length, only the last line may be shorter,
+    // followed by the ending offset (display only)
+    size_t length = endoffset - offset;
+    size_t rest = length % options->width;
+    writer.line_length = get_line_length(&writer, options->width);
+    uqword_t size = (uqword_t)(length / options->width) * writer.line_length + ((rest > 0) ? get_line_length(&writer, rest) : 0);
+    uqword_t ending = (options->output == OUTPUT_TEXT) ? writer.ndigits + sizeof(WRITE_LINE_END) - 1 : 0;
+
+    // Output file gets its final size right away, workers only fill it
+    FILE* out = fopen(target, "wb");
+    if (!out) {
+        // Output file couldn't be created
+        print_file_error("Output file couldn\'t be created");
+
+        return errno;
+    }
+
+    if (_chsize_s(_fileno(out), (long long)(size + ending)) != 0) {
+        // Not enough space for output file
+        int error = errno;
+        fclose(out);
+        print_file_error("Output file couldn\'t be preallocated");
+
+        return error;
+    }
+
+    if (ending > 0) {
+        // Ending offset is known from the beginning
+        _fseeki64(out, (long long)size, SEEK_SET);
+        print_offset(out, writer.ndigits, endoffset);
+        fputs(WRITE_LINE_END, out);
+    }
+
+    if (fclose(out) != 0) {
+        // An error occured while writing output file
+        print_file_error("An error occured while writing output file");
+
+        return errno;
+    }
+
+    // Every worker takes chunks from the shared output file
+    writer_t* contexts[MAX_WORKERS];
+    for (unsigned int i = 0; i < MAX_WORKERS; ++i)
+        contexts[i] = &writer;
+
+    workers_t running;
+    running.count = 0;
+    unsigned int njobs = (writer.chunk_count < workers) ? (unsigned int)writer.chunk_count : workers;
+
+    if (njobs < 2 || !workers_start(&running, njobs, writer_worker, contexts, sizeof(writer_t*)))
+        // Single worker (or threads unavailable) -> dump on this thread
+        writer_worker(&contexts[0]);
+    workers_wait(&running);
+
+    if (writer.error != 0) {
+        // Some chunk couldn't be read, rendered or written
+        errno = writer.error;
+        print_file_error("An error occured while writing output file");
+
+        return writer.error;
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**************************************************
+ * Hexdump for Windows
+ *-------------------------------------------------
+ *
+ * Command line tool inspired by Linux tool
+ * hexdump - stripped to bare hexadecimal dump
+ * of given file with option to limit dump length
+ *
+ * File: writer.h
+ *
+ *-------------------------------------------------
+ * Made by Marek Poláček (Polda18)
+ **************************************************/
+
+#pragma once
+
+#include <stdbool.h>                    // Measure for boolean type
+#include "dumps.h"                      // Measure for dump format and options
+#ifndef __WRITER_H__
+#define __WRITER_H__
+
+// Define constants
+#define WRITE_CHUNK_SIZE                1048576     // Input bytes rendered by a worker at once (rounded down to whole lines)
+#define WRITE_LINE_END                  "\r\n"      // Line ending of output file (same as redirected console output)
+
+// Output file shared by all workers
+typedef struct writer {
+    const char* path;                   // Input file path
+    const char* target;                 // Output file path
+    const dump_format_t* format;        // Line format
+    const dump_options_t* options;      // Dump options
+    size_t ndigits;                     // Offset digits
+    size_t offset;                      // Initial offset
+    size_t endoffset;                   // End offset
+    size_t chunk_size;                  // Input bytes of one chunk
+    size_t chunk_count;                 // Number of chunks
+    size_t line_length;                 // Output bytes of a full line
+    volatile long next;                 // Next chunk to be taken by a worker
+    volatile long error;                // First error (0 if there is none)
+    size_t* position;                   // Position watched by progress (advanced atomically)
+} writer_t;
+
+// Declare functions
+bool write_supported(
+    const dump_format_t* format,
+    const dump_options_t* options
+);      // Check if lines of given format and options have a fixed length
+int write_file(
+    const char* path,
+    const char* target,
+    const dump_format_t* format,
+    const dump_options_t* options,
+    size_t offset,
+    size_t* position,
+    size_t endoffset,
+    unsigned int workers
+);      // Dump range of a file into output file, workers write their chunks at computed offsets
+
+#endif